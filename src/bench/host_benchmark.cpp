@@ -0,0 +1,237 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* External library headers */
+#include "cxxopts.hpp"
+
+/* Project's headers */
+#include "src/host/random_access_definitions.h"
+#include "src/host/verification.h"
+
+/**
+Number of starts() calls measured per thread
+*/
+#define STARTS_CALLS 1024
+
+/*
+Microbenchmark of the host code that is executed before and after the
+kernels. Every routine is executed concurrently by the given number of
+threads, each on its own data array of the given size. No OpenCL device is
+needed.
+*/
+namespace bm_bench {
+
+/**
+A routine that is measured on a data array of a single thread
+*/
+struct Routine {
+    std::string name;
+    // Bytes read or written per item of the data array
+    double bytesPerItem;
+    void (*run)(DATA_TYPE_UNSIGNED* data,
+                std::vector<DATA_TYPE_UNSIGNED*> const &chunks,
+                size_t dataSize);
+};
+
+/*
+Calculates the random numbers of UPDATE_SPLIT positions like the host code
+of single_rnd and ndrange, repeated to get a measurable time
+*/
+static void
+runStarts(DATA_TYPE_UNSIGNED* data,
+          std::vector<DATA_TYPE_UNSIGNED*> const &chunks, size_t dataSize) {
+    for (int i = 0; i < STARTS_CALLS; i++) {
+        data[i % dataSize] = starts((4 * dataSize) / STARTS_CALLS * i);
+    }
+}
+
+/*
+Fills the data array with the initial values
+*/
+static void
+runInitialize(DATA_TYPE_UNSIGNED* data,
+              std::vector<DATA_TYPE_UNSIGNED*> const &chunks,
+              size_t dataSize) {
+    bm_verification::initializeData(data, dataSize, 0);
+}
+
+/*
+Copies the chunks of all replications into the data array
+*/
+static void
+runMerge(DATA_TYPE_UNSIGNED* data,
+         std::vector<DATA_TYPE_UNSIGNED*> const &chunks, size_t dataSize) {
+    bm_verification::mergeChunks(chunks, data, dataSize);
+}
+
+/*
+Replays the XOR updates of a kernel execution on the data array
+*/
+static void
+runReplay(DATA_TYPE_UNSIGNED* data,
+          std::vector<DATA_TYPE_UNSIGNED*> const &chunks, size_t dataSize) {
+    bm_verification::replayUpdates(data, dataSize);
+}
+
+/*
+Executes a routine with the given number of threads
+
+@return the best time of all repetitions in seconds
+*/
+static double
+measure(Routine const &routine, size_t dataSize, uint threads,
+        uint repetitions, uint replications) {
+    std::vector<DATA_TYPE_UNSIGNED*> tables(threads);
+    std::vector<std::vector<DATA_TYPE_UNSIGNED*>> chunks(threads);
+    for (uint t = 0; t < threads; t++) {
+        posix_memalign(reinterpret_cast<void **>(&tables[t]), 64,
+                       ENTRY_SIZE * dataSize);
+        bm_verification::initializeData(tables[t], dataSize, 0);
+        for (uint r = 0; r < replications; r++) {
+            DATA_TYPE_UNSIGNED* chunk;
+            posix_memalign(reinterpret_cast<void **>(&chunk), 64,
+                    ENTRY_SIZE * (dataSize / replications));
+            bm_verification::initializeData(chunk, dataSize / replications,
+                                            r * (dataSize / replications));
+            chunks[t].push_back(chunk);
+        }
+    }
+
+    double best = 0;
+    for (uint i = 0; i < repetitions; i++) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> workers;
+        for (uint t = 0; t < threads; t++) {
+            workers.push_back(std::thread(routine.run, tables[t],
+                                          std::cref(chunks[t]), dataSize));
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        auto t2 = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> timespan =
+            std::chrono::duration_cast<std::chrono::duration<double>>
+                                                                (t2 - t1);
+        if (i == 0 || timespan.count() < best) {
+            best = timespan.count();
+        }
+    }
+
+    for (uint t = 0; t < threads; t++) {
+        free(reinterpret_cast<void *>(tables[t]));
+        for (DATA_TYPE_UNSIGNED* chunk : chunks[t]) {
+            free(reinterpret_cast<void *>(chunk));
+        }
+    }
+    return best;
+}
+
+}  // namespace bm_bench
+
+/**
+The entry point of the microbenchmark
+*/
+int
+main(int argc, char * argv[]) {
+    cxxopts::Options options(argv[0], "Microbenchmark of the host code of "\
+                             "the random access benchmark");
+    options.add_options()
+        ("min-size", "Smallest data array in items given as power of two",
+            cxxopts::value<uint>()->default_value("16"))
+        ("max-size", "Largest data array in items given as power of two",
+            cxxopts::value<uint>()->default_value("26"))
+        ("threads", "Maximum number of threads. The number of threads is "\
+        "doubled starting with one.",
+            cxxopts::value<uint>()->default_value(
+                std::to_string(std::thread::hardware_concurrency())))
+        ("n", "Number of repetitions. The best time is reported.",
+            cxxopts::value<uint>()->default_value("3"))
+        ("r", "Number of chunks that are merged",
+            cxxopts::value<uint>()->default_value(std::to_string(REPLICATIONS)))
+        ("h,help", "Print this help");
+    cxxopts::ParseResult result = options.parse(argc, argv);
+    if (result.count("h")) {
+        std::cout << options.help() << std::endl;
+        exit(0);
+    }
+    uint maxThreads = std::max(result["threads"].as<uint>(), 1u);
+
+    // The replay does four updates with a read and write per item
+    std::vector<bm_bench::Routine> routines = {
+        {"starts", 0, bm_bench::runStarts},
+        {"initialize", ENTRY_SIZE, bm_bench::runInitialize},
+        {"merge", 2 * ENTRY_SIZE, bm_bench::runMerge},
+        {"replay", 8 * ENTRY_SIZE, bm_bench::runReplay}};
+
+    std::cout << std::setw(ENTRY_SPACE) << "routine"
+              << std::setw(ENTRY_SPACE) << "items"
+              << std::setw(ENTRY_SPACE) << "threads"
+              << std::setw(ENTRY_SPACE) << "best t[s]"
+              << std::setw(ENTRY_SPACE) << "ns/item"
+              << std::setw(ENTRY_SPACE) << "GB/s" << std::endl;
+    for (bm_bench::Routine const &routine : routines) {
+        for (uint s = result["min-size"].as<uint>();
+                s <= result["max-size"].as<uint>(); s++) {
+            size_t dataSize = static_cast<size_t>(1) << s;
+            for (uint threads = 1; threads <= maxThreads; threads *= 2) {
+                double time = bm_bench::measure(routine, dataSize, threads,
+                                                result["n"].as<uint>(),
+                                                result["r"].as<uint>());
+                // starts() is measured per call instead of per item
+                double items = (routine.bytesPerItem > 0)
+                                    ? static_cast<double>(dataSize)
+                                    : STARTS_CALLS;
+                std::cout << std::setw(ENTRY_SPACE) << routine.name
+                          << std::setw(ENTRY_SPACE)
+                          << static_cast<size_t>(items)
+                          << std::setw(ENTRY_SPACE) << threads
+                          << std::setw(ENTRY_SPACE) << time
+                          << std::setw(ENTRY_SPACE)
+                          << time * 1.0e9 / (items * threads);
+                if (routine.bytesPerItem > 0) {
+                    std::cout << std::setw(ENTRY_SPACE)
+                              << routine.bytesPerItem * items * threads
+                                                        / time * 1.0e-9;
+                } else {
+                    std::cout << std::setw(ENTRY_SPACE) << "-";
+                }
+                std::cout << std::endl;
+            }
+            // starts() does not depend on the data size
+            if (routine.bytesPerItem <= 0) {
+                break;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Kernels that are added to the bitstreams of all kernel types if they are
+enabled with the corresponding define. The file is replicated by the code
+generator like the kernel files and included at their end, so it relies on
+the definitions of random_access_kernels_common.h and UPDATE_SPLIT.
+*/
+
+#ifdef BANDWIDTH_KERNEL
+/*
+Kernel, that sequentially reads and writes back the data chunk of a
+replication. Every entry is XORed with the given value, so the same amount of
+data is modified like in the random access kernels but with the maximum
+memory bandwidth. It is used as a baseline for the efficiency of the random
+accesses.
+
+@param data The data chunk that will be updated
+@param data_chunk The number of entries in the data chunk
+@param value The value that is XORed to every word
+*/
+// PY_CODE_GEN block_start
+__attribute__((max_global_work_dim(0)))
+__kernel
+void streamMemory$repl$(__global ENTRY_TYPE* restrict data,
+                        DATA_TYPE_UNSIGNED data_chunk,
+                        DATA_TYPE_UNSIGNED value) {
+    #pragma unroll GLOBAL_MEM_UNROLL
+    #pragma ivdep array(data)
+    for (DATA_TYPE_UNSIGNED i=0; i < data_chunk; i++) {
+        data[i] ^= value;
+    }
+}
+// PY_CODE_GEN block_end [replace(replace_dict=locals()) for repl in range(replications)]
+#endif
+
+#ifdef LATENCY_KERNEL
+/*
+Kernel, that follows a chain of pointers through the data chunk of a
+replication. Every item contains the index of the next item that is read,
+so all reads depend on each other and the memory latency can not be hidden.
+
+@param data The data chunk containing a cyclic permutation of indices
+@param steps The number of dependent reads
+@param result The index reached after the last read. Used to keep the chain
+        of reads from being optimized away.
+*/
+// PY_CODE_GEN block_start
+__attribute__((max_global_work_dim(0)))
+__kernel
+void chaseMemory$repl$(
+        __global volatile const DATA_TYPE_UNSIGNED* restrict data,
+        DATA_TYPE_UNSIGNED steps,
+        __global DATA_TYPE_UNSIGNED* restrict result) {
+    DATA_TYPE_UNSIGNED next = 0;
+    for (DATA_TYPE_UNSIGNED i=0; i < steps; i++) {
+        next = data[next];
+    }
+    result[0] = next;
+}
+// PY_CODE_GEN block_end [replace(replace_dict=locals()) for repl in range(replications)]
+#endif
+
+#ifdef OUT_OF_CORE_KERNEL
+#if ENTRY_WIDTH != 1
+#error "The out-of-core kernel only supports ENTRY_WIDTH 1"
+#endif
+/*
+Kernel, that applies a block of updates to the window of the data array that
+is currently placed on the device. The host streams the random numbers of all
+updates that address the chunk of this replication in their original order,
+so the addresses can be calculated from them like in the other kernels.
+The addresses of a block fall into the small chunk of the window, so
+consecutive updates often hit the same address. The dependency through data
+is therefore kept and the updates are applied one after another without
+losing updates.
+OPERATION_GATHER is not supported by this kernel.
+
+@param data The chunk of the window that is updated
+@param updates The random numbers of the updates
+@param count Number of updates in the block
+@param m The size of the whole data array
+@param address_start The address of the first item of data in the whole
+        data array
+*/
+// PY_CODE_GEN block_start
+__attribute__((max_global_work_dim(0)))
+__kernel
+void applyUpdates$repl$(__global DATA_TYPE_UNSIGNED* restrict data,
+                        __global const DATA_TYPE_UNSIGNED* restrict updates,
+                        DATA_TYPE_UNSIGNED count,
+                        DATA_TYPE_UNSIGNED m,
+                        DATA_TYPE_UNSIGNED address_start) {
+    for (DATA_TYPE_UNSIGNED i=0; i < count; i++) {
+        DATA_TYPE_UNSIGNED const value = updates[i];
+        DATA_TYPE_UNSIGNED const address = value & (m - 1);
+        DATA_TYPE_UNSIGNED const local_address = address - address_start;
+        DATA_TYPE_UNSIGNED const loaded = data[local_address];
+        STORE_UPDATE(data, local_address, loaded, value, address);
+    }
+}
+// PY_CODE_GEN block_end [replace(replace_dict=locals()) for repl in range(replications)]
+#endif
+
+#ifdef MULTI_TENANT_KERNEL
+/*
+Kernel, that updates the table of a tenant in the multi-tenant mode. Every
+tenant owns an independent table and continues the update sequence at its own
+offset, so the tenants update their tables with different random numbers.
+The updates are done in batches of UPDATE_SPLIT like in the single kernel.
+
+@param data The table of the tenant
+@param m The size of the table
+@param seed The random number the update sequence of the tenant starts with
+@param checksum Only for GATHER: XOR of all loaded values
+*/
+// PY_CODE_GEN block_start
+__attribute__((max_global_work_dim(0)))
+__kernel
+void tenantMemory$repl$(__global volatile ENTRY_TYPE* restrict data,
+                        DATA_TYPE_UNSIGNED m,
+                        DATA_TYPE_UNSIGNED seed
+#if OPERATION == OPERATION_GATHER
+                        , __global ENTRY_TYPE* restrict checksum
+#endif
+                        ) {
+    DATA_TYPE_UNSIGNED ran = seed;
+    ENTRY_TYPE local_checksum = 0;
+
+    for (DATA_TYPE_UNSIGNED i=0; i < 4 * m / UPDATE_SPLIT; i++) {
+
+        DATA_TYPE_UNSIGNED local_address[UPDATE_SPLIT];
+        ENTRY_TYPE loaded_data[UPDATE_SPLIT];
+        DATA_TYPE_UNSIGNED update_val[UPDATE_SPLIT];
+
+        // calculate next addresses
+        for (int ld=0; ld < UPDATE_SPLIT; ld++) {
+            DATA_TYPE v = 0;
+            if (((DATA_TYPE) ran) < 0) {
+                v = POLY;
+            }
+            ran = (ran << 1) ^ v;
+            update_val[ld] = ran;
+            local_address[ld] = ran & (m - 1);
+        }
+
+        // load the data of the calculated addresses from global memory
+        #if OPERATION != OPERATION_SCATTER
+        #pragma unroll GLOBAL_MEM_UNROLL
+        #pragma ivdep array(data)
+        for (int ld=0; ld < UPDATE_SPLIT; ld++) {
+            loaded_data[ld] = data[local_address[ld]];
+        }
+        #endif
+
+        #if OPERATION == OPERATION_GATHER
+        #pragma unroll GLOBAL_MEM_UNROLL
+        for (int ld=0; ld < UPDATE_SPLIT; ld++) {
+            local_checksum ^= loaded_data[ld];
+        }
+        #else
+        // store back the updated data
+        #pragma unroll GLOBAL_MEM_UNROLL
+        #pragma ivdep array(data)
+        for (int ld=0; ld < UPDATE_SPLIT; ld++) {
+            STORE_UPDATE(data, local_address[ld], loaded_data[ld],
+                         update_val[ld], local_address[ld]);
+        }
+        #endif
+    }
+
+    #if OPERATION == OPERATION_GATHER
+    checksum[0] = local_checksum;
+    #endif
+}
+// PY_CODE_GEN block_end [replace(replace_dict=locals()) for repl in range(replications)]
+#endif
@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+Definitions shared by the random access kernels of all types. The kernel
+files include this header before their own definitions, so every default can
+still be overridden with the compile flags of aoc.
+*/
+#ifndef SRC_DEVICE_RANDOM_ACCESS_KERNELS_COMMON_H_
+#define SRC_DEVICE_RANDOM_ACCESS_KERNELS_COMMON_H_
+
+/*
+The data type used for the data array.
+*/
+#ifndef DATA_TYPE
+#define DATA_TYPE long
+#endif
+
+/*
+Unsigned version of the data type used for the data array.
+*/
+#ifndef DATA_TYPE_UNSIGNED
+#define DATA_TYPE_UNSIGNED ulong
+#endif
+
+/*
+Number of words of DATA_TYPE_UNSIGNED in an entry of the data array. Every
+update loads and stores a whole entry and applies its random number to all
+words of the entry. The host initializes word w of entry a with
+a * ENTRY_WIDTH + w.
+*/
+#ifndef ENTRY_WIDTH
+#define ENTRY_WIDTH 1
+#endif
+
+/*
+Type of an entry of the data array. Entries with more than one word are
+vector types like ulong4, so they are loaded and stored with a single access.
+*/
+#if ENTRY_WIDTH == 1
+#define ENTRY_TYPE DATA_TYPE_UNSIGNED
+#define ENTRY_FIRST(entry) (entry)
+#else
+#define ENTRY_VECTOR(type, width) type ## width
+#define ENTRY_EXPAND(type, width) ENTRY_VECTOR(type, width)
+#define ENTRY_TYPE ENTRY_EXPAND(DATA_TYPE_UNSIGNED, ENTRY_WIDTH)
+#define ENTRY_FIRST(entry) ((entry).s0)
+#endif
+
+/*
+Initial value of the first word of the entry with the given global address
+*/
+#define ENTRY_INITIAL(address) ((address) * ENTRY_WIDTH)
+
+/*
+Unrolling factor for the read and write pipelines of each kernel.
+*/
+#ifndef GLOBAL_MEM_UNROLL
+#define GLOBAL_MEM_UNROLL 4
+#endif
+
+/*
+Constant used to update the pseudo random number
+*/
+#define POLY 7
+
+/*
+Operations that can be used to update the data array. The operation is
+selected with OPERATION and the host has to verify the data using the same
+operation.
+*/
+#define OPERATION_XOR 0
+#define OPERATION_ADD 1
+#define OPERATION_SCATTER 2
+#define OPERATION_GATHER 3
+#define OPERATION_CAS 4
+
+#ifndef OPERATION
+#define OPERATION OPERATION_XOR
+#endif
+
+/*
+Stores the updated value of a single entry. The value is applied to all words
+of the entry.
+CAS only replaces entries that still contain their initial value, which is
+checked with the first word. GATHER does not store any data.
+*/
+#if OPERATION == OPERATION_ADD
+#define STORE_UPDATE(data, index, loaded, value, address) \
+    data[index] = (loaded) + (value)
+#elif OPERATION == OPERATION_SCATTER
+#define STORE_UPDATE(data, index, loaded, value, address) \
+    data[index] = (ENTRY_TYPE)(value)
+#elif OPERATION == OPERATION_CAS
+#define STORE_UPDATE(data, index, loaded, value, address) \
+    if (ENTRY_FIRST(loaded) == ENTRY_INITIAL(address)) { \
+        data[index] = (ENTRY_TYPE)(value); \
+    }
+#else
+#define STORE_UPDATE(data, index, loaded, value, address) \
+    data[index] = (loaded) ^ (value)
+#endif
+
+/*
+Number of equally sized blocks of the data array that are ranked by the
+address distribution. Has to be a power of two and the same as on the host.
+*/
+#ifndef DISTRIBUTION_BLOCKS
+#define DISTRIBUTION_BLOCKS 4096
+#endif
+
+/*
+Number of slots in the block table of the address distribution. Every slot
+stores a block, so the probability of a block is a multiple of
+1 / DISTRIBUTION_SLOTS. Has to be a power of two multiple of
+DISTRIBUTION_BLOCKS and the same as on the host.
+*/
+#ifndef DISTRIBUTION_SLOTS
+#define DISTRIBUTION_SLOTS (16 * DISTRIBUTION_BLOCKS)
+#endif
+
+/*
+Moves the uniform address of an update to the block stored in the slot of
+its segment in the block table, so the updates follow the address
+distribution selected on the host. The data array is split into one segment
+per slot. The segment within the block is selected with the random bits
+above the address and the offset within the segment is kept, so all entries
+of a block are updated.
+*/
+#ifdef ADDRESS_DISTRIBUTION
+#define DISTRIBUTE_ADDRESS(ran, address) \
+    ((((DATA_TYPE_UNSIGNED) local_block_table[(address) >> segment_shift]) \
+      << block_shift) \
+     | ((((ran) >> address_bits) \
+         & (DISTRIBUTION_SLOTS / DISTRIBUTION_BLOCKS - 1)) << segment_shift) \
+     | ((address) & segment_offset_mask))
+#else
+#define DISTRIBUTE_ADDRESS(ran, address) (address)
+#endif
+
+/*
+Merges the value of an update into the value of an earlier update to the same
+address within a batch, so a single store gives the same result as executing
+both updates in order. For CAS the later value is only used if the earlier
+value equals the initial value of the first word of the entry.
+*/
+#if OPERATION == OPERATION_ADD
+#define MERGE_UPDATE(first, value, address) ((first) + (value))
+#elif OPERATION == OPERATION_SCATTER
+#define MERGE_UPDATE(first, value, address) (value)
+#elif OPERATION == OPERATION_CAS
+#define MERGE_UPDATE(first, value, address) \
+    (((first) == ENTRY_INITIAL(address)) ? (value) : (first))
+#else
+#define MERGE_UPDATE(first, value, address) ((first) ^ (value))
+#endif
+
+#endif  // SRC_DEVICE_RANDOM_ACCESS_KERNELS_COMMON_H_
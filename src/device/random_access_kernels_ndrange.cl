@@ -20,35 +20,81 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#define DATA_TYPE long
-#define DATA_TYPE_UNSIGNED unsigned DATA_TYPE
+#include "random_access_kernels_common.h"
 
 #ifndef UPDATE_SPLIT
 #define UPDATE_SPLIT 1024
 #endif
 
-#define POLY 7
+// PY_CODE_GEN block_start
+#define SINGLE_KERNEL
+// PY_CODE_GEN block_end if_cond(replications == 1, CODE, None)
 
+/*
+Kernel, that will update the given data array accoring to a predefined pseudo-
+random access scheme. Every work item starts with its own pre-calculated
+random number. The overall data array might be equally split between
+multiple kernels. In that case, the index of the current split can be given
+to the kernel.
 
+@param data The data array that will be updated
+@param ran_const precalculated random numbers. One for every work item.
+@param m The size of the data array
+@param data_chunk The chunk index that has to be updated by the kernel
+@param checksum Only for GATHER: XOR of all loaded values for every work item
+*/
+// PY_CODE_GEN block_start
 // SIMD not used, and instead CU replication since we have random accesses
 __attribute__((num_simd_work_items(1)))
 __attribute__((num_compute_units(UPDATE_SPLIT)))
 __kernel
-void accessMemory(__global volatile DATA_TYPE_UNSIGNED* restrict data,
-                  __global const DATA_TYPE_UNSIGNED* restrict ran_const,
-                  ulong m) {
+void accessMemory$repl$(__global volatile ENTRY_TYPE* restrict data,
+                        __global const DATA_TYPE_UNSIGNED* restrict ran_const,
+                        DATA_TYPE_UNSIGNED m,
+                        DATA_TYPE_UNSIGNED data_chunk
+#if OPERATION == OPERATION_GATHER
+                        , __global ENTRY_TYPE* restrict checksum
+#endif
+                        ) {
     DATA_TYPE_UNSIGNED ran = ran_const[get_global_id(0)];
 
-    uint mupdate = 4 * m;
+    // calculate the start of the address range this kernel is responsible for
+    #ifndef SINGLE_KERNEL
+    DATA_TYPE_UNSIGNED const address_start = $repl$ * data_chunk;
+    #else
+    DATA_TYPE_UNSIGNED const address_start = 0;
+    #endif
+
+    DATA_TYPE_UNSIGNED const mupdate = 4 * m;
+    ENTRY_TYPE local_checksum = 0;
     // do random accesses
-    for (int i=0; i< mupdate / UPDATE_SPLIT; i++) {
+    for (DATA_TYPE_UNSIGNED i=0; i< mupdate / UPDATE_SPLIT; i++) {
         DATA_TYPE_UNSIGNED v = 0;
         if (((DATA_TYPE) ran) < 0) {
             v = POLY;
         }
         ran = (ran << 1) ^ v;
         DATA_TYPE_UNSIGNED address = ran & (m - 1);
-        data[address] ^= ran;
-
+        DATA_TYPE_UNSIGNED local_address = address - address_start;
+        #ifndef SINGLE_KERNEL
+        if (local_address < data_chunk)
+        #endif
+        {
+            #if OPERATION == OPERATION_GATHER
+            local_checksum ^= data[local_address];
+            #else
+            ENTRY_TYPE loaded = data[local_address];
+            STORE_UPDATE(data, local_address, loaded, ran, address);
+            #endif
+        }
     }
+
+    #if OPERATION == OPERATION_GATHER
+    checksum[get_global_id(0)] = local_checksum;
+    #endif
 }
+// PY_CODE_GEN block_end [replace(replace_dict=locals()) for repl in range(replications)]
+
+// PY_CODE_GEN block_start
+#include "random_access_auxiliary_kernels_$replications$.cl"
+// PY_CODE_GEN block_end replace()
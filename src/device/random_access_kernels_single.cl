@@ -20,31 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-/*
-The data type used for the data array.
-*/
-#ifndef DATA_TYPE
-#define DATA_TYPE long
-#endif
-
-/*
-Unsigned version of the data type used for the data array.
-*/
-#ifndef DATA_TYPE_UNSIGNED
-#define DATA_TYPE_UNSIGNED ulong
-#endif
-
-/*
-Unrolling factor for the read and write pipelines of each kernel.
-*/
-#ifndef GLOBAL_MEM_UNROLL
-#define GLOBAL_MEM_UNROLL 4
-#endif
-
-/*
-Constant used to update the pseudo random number
-*/
-#define POLY 7
+#include "random_access_kernels_common.h"
 
 // PY_CODE_GEN block_start
 #define SINGLE_KERNEL
@@ -68,28 +44,64 @@ to the kernel.
 @param data The data array that will be updated
 @param m The size of the data array
 @param data_chunk The chunk index that has to be updated by the kernel
+@param checksum Only for GATHER: XOR of all loaded values
+@param block_table Only for ADDRESS_DISTRIBUTION: block of every slot of the
+        address distribution
 */
 // PY_CODE_GEN block_start
 __attribute__((max_global_work_dim(0)))
 __kernel
-void accessMemory$repl$(__global volatile DATA_TYPE_UNSIGNED* restrict data,
+void accessMemory$repl$(__global volatile ENTRY_TYPE* restrict data,
                         DATA_TYPE_UNSIGNED m,
-                        DATA_TYPE_UNSIGNED data_chunk) {
+                        DATA_TYPE_UNSIGNED data_chunk
+#if OPERATION == OPERATION_GATHER
+                        , __global ENTRY_TYPE* restrict checksum
+#endif
+#ifdef ADDRESS_DISTRIBUTION
+                        , __global const uint* restrict block_table
+#endif
+                        ) {
     // Initiate the pseudo random number
     DATA_TYPE_UNSIGNED ran = 1;
 
     // calculate the start of the address range this kernel is responsible for
     #ifndef SINGLE_KERNEL
     DATA_TYPE_UNSIGNED const address_start = $repl$ * data_chunk;
+    #else
+    DATA_TYPE_UNSIGNED const address_start = 0;
     #endif
 
     DATA_TYPE_UNSIGNED const mupdate = 4 * m;
+    ENTRY_TYPE local_checksum = 0;
+
+    #ifdef ADDRESS_DISTRIBUTION
+    // copy the block table to local memory and calculate the number of
+    // address bits within a segment, within a block and of the data array
+    uint local_block_table[DISTRIBUTION_SLOTS];
+    for (int s=0; s < DISTRIBUTION_SLOTS; s++) {
+        local_block_table[s] = block_table[s];
+    }
+    int segment_shift = 0;
+    while (((DATA_TYPE_UNSIGNED) DISTRIBUTION_SLOTS << segment_shift) < m) {
+        segment_shift++;
+    }
+    int block_shift = segment_shift;
+    while (((DATA_TYPE_UNSIGNED) DISTRIBUTION_BLOCKS << block_shift) < m) {
+        block_shift++;
+    }
+    int address_bits = block_shift;
+    while (((DATA_TYPE_UNSIGNED) 1 << address_bits) < m) {
+        address_bits++;
+    }
+    DATA_TYPE_UNSIGNED const segment_offset_mask =
+                                ((DATA_TYPE_UNSIGNED) 1 << segment_shift) - 1;
+    #endif
 
     // do random accesses
     for (DATA_TYPE_UNSIGNED i=0; i< mupdate / UPDATE_SPLIT; i++) {
 
         DATA_TYPE_UNSIGNED local_address[UPDATE_SPLIT];
-        DATA_TYPE_UNSIGNED loaded_data[UPDATE_SPLIT];
+        ENTRY_TYPE loaded_data[UPDATE_SPLIT];
         DATA_TYPE_UNSIGNED writeback_data[UPDATE_SPLIT];
         DATA_TYPE_UNSIGNED update_val[UPDATE_SPLIT];
 
@@ -101,7 +113,8 @@ void accessMemory$repl$(__global volatile DATA_TYPE_UNSIGNED* restrict data,
             }
             ran = (ran << 1) ^ v;
             update_val[ld] = ran;
-            DATA_TYPE_UNSIGNED address = ran & (m - 1);
+            DATA_TYPE_UNSIGNED address =
+                                    DISTRIBUTE_ADDRESS(ran, ran & (m - 1));
             #ifndef SINGLE_KERNEL
             local_address[ld] = address - address_start;
             #else
@@ -110,6 +123,7 @@ void accessMemory$repl$(__global volatile DATA_TYPE_UNSIGNED* restrict data,
         }
 
         // load the data of the calculated addresses from global memory
+        #if OPERATION != OPERATION_SCATTER
         #pragma unroll GLOBAL_MEM_UNROLL
         #pragma ivdep array(data)
         for (int ld=0; ld< UPDATE_SPLIT; ld++) {
@@ -121,19 +135,43 @@ void accessMemory$repl$(__global volatile DATA_TYPE_UNSIGNED* restrict data,
             }
             #endif
         }
+        #endif
 
+        #if OPERATION == OPERATION_GATHER
+        // accumulate the loaded data instead of storing it back
+        #pragma unroll GLOBAL_MEM_UNROLL
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            #ifndef SINGLE_KERNEL
+            if (local_address[ld] < data_chunk)
+            #endif
+            {
+                local_checksum ^= loaded_data[ld];
+            }
+        }
+        #else
         // store back the calculated addresses from global memory
         #pragma unroll GLOBAL_MEM_UNROLL
         #pragma ivdep array(data)
         for (int ld=0; ld< UPDATE_SPLIT; ld++) {
             #ifdef SINGLE_KERNEL
-            data[local_address[ld]] = loaded_data[ld] ^update_val[ld];
+            STORE_UPDATE(data, local_address[ld], loaded_data[ld],
+                         update_val[ld], local_address[ld]);
             #else
             if (local_address[ld] < data_chunk) {
-                data[local_address[ld]] = loaded_data[ld] ^ update_val[ld];
+                STORE_UPDATE(data, local_address[ld], loaded_data[ld],
+                             update_val[ld], local_address[ld] + address_start);
             }
             #endif
         }
+        #endif
     }
+
+    #if OPERATION == OPERATION_GATHER
+    checksum[0] = local_checksum;
+    #endif
 }
 // PY_CODE_GEN block_end [replace(replace_dict=locals()) for repl in range(replications)]
+
+// PY_CODE_GEN block_start
+#include "random_access_auxiliary_kernels_$replications$.cl"
+// PY_CODE_GEN block_end replace()
@@ -0,0 +1,207 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "random_access_kernels_common.h"
+
+// PY_CODE_GEN block_start
+#define SINGLE_KERNEL
+// PY_CODE_GEN block_end if_cond(replications == 1, CODE, None)
+
+/*
+The size of the local memory buffer.
+If it is chosen too big, the experienced error might increase because Multiple
+updates to the same memory address within this range will be overridden.
+*/
+#ifndef UPDATE_SPLIT
+#define UPDATE_SPLIT 1024
+#endif
+
+/*
+Number of entries at the start of the data chunk of every replication that
+are kept in on-chip memory during the whole kernel execution. Updates to
+these entries are applied in order to the cache, so they are never lost and
+do not access the global memory. Skewed address distributions place their
+hottest blocks at the start of every chunk.
+*/
+#ifndef CACHE_SIZE
+#define CACHE_SIZE 8192
+#endif
+
+/*
+Kernel, that will update the given data array accoring to a predefined pseudo-
+random access scheme. The overall data array might be equally split between
+multiple kernels. In that case, the index of the current split can be given
+to the kernel.
+The first CACHE_SIZE entries of the chunk are loaded into local memory before
+the updates and written back after them. Updates to cached entries are
+applied in order to the local copy, the remaining updates of a batch are
+loaded and stored like in the single kernel.
+
+@param data The data array that will be updated
+@param m The size of the data array
+@param data_chunk The chunk index that has to be updated by the kernel
+@param checksum Only for GATHER: XOR of all loaded values
+@param block_table Only for ADDRESS_DISTRIBUTION: block of every slot of the
+        address distribution
+*/
+// PY_CODE_GEN block_start
+__attribute__((max_global_work_dim(0)))
+__kernel
+void accessMemory$repl$(__global volatile ENTRY_TYPE* restrict data,
+                        DATA_TYPE_UNSIGNED m,
+                        DATA_TYPE_UNSIGNED data_chunk
+#if OPERATION == OPERATION_GATHER
+                        , __global ENTRY_TYPE* restrict checksum
+#endif
+#ifdef ADDRESS_DISTRIBUTION
+                        , __global const uint* restrict block_table
+#endif
+                        ) {
+    // Initiate the pseudo random number
+    DATA_TYPE_UNSIGNED ran = 1;
+
+    // calculate the start of the address range this kernel is responsible for
+    #ifndef SINGLE_KERNEL
+    DATA_TYPE_UNSIGNED const address_start = $repl$ * data_chunk;
+    DATA_TYPE_UNSIGNED const chunk_size = data_chunk;
+    #else
+    DATA_TYPE_UNSIGNED const address_start = 0;
+    DATA_TYPE_UNSIGNED const chunk_size = m;
+    #endif
+
+    DATA_TYPE_UNSIGNED const mupdate = 4 * m;
+    ENTRY_TYPE local_checksum = 0;
+
+    #ifdef ADDRESS_DISTRIBUTION
+    // copy the block table to local memory and calculate the number of
+    // address bits within a segment, within a block and of the data array
+    uint local_block_table[DISTRIBUTION_SLOTS];
+    for (int s=0; s < DISTRIBUTION_SLOTS; s++) {
+        local_block_table[s] = block_table[s];
+    }
+    int segment_shift = 0;
+    while (((DATA_TYPE_UNSIGNED) DISTRIBUTION_SLOTS << segment_shift) < m) {
+        segment_shift++;
+    }
+    int block_shift = segment_shift;
+    while (((DATA_TYPE_UNSIGNED) DISTRIBUTION_BLOCKS << block_shift) < m) {
+        block_shift++;
+    }
+    int address_bits = block_shift;
+    while (((DATA_TYPE_UNSIGNED) 1 << address_bits) < m) {
+        address_bits++;
+    }
+    DATA_TYPE_UNSIGNED const segment_offset_mask =
+                                ((DATA_TYPE_UNSIGNED) 1 << segment_shift) - 1;
+    #endif
+
+    // load the cached entries at the start of the chunk
+    DATA_TYPE_UNSIGNED const cached_size = (chunk_size < CACHE_SIZE)
+                                            ? chunk_size : CACHE_SIZE;
+    ENTRY_TYPE cache[CACHE_SIZE];
+    #pragma unroll GLOBAL_MEM_UNROLL
+    for (DATA_TYPE_UNSIGNED c=0; c < cached_size; c++) {
+        cache[c] = data[c];
+    }
+
+    // do random accesses
+    for (DATA_TYPE_UNSIGNED i=0; i< mupdate / UPDATE_SPLIT; i++) {
+
+        DATA_TYPE_UNSIGNED local_address[UPDATE_SPLIT];
+        ENTRY_TYPE loaded_data[UPDATE_SPLIT];
+        DATA_TYPE_UNSIGNED update_val[UPDATE_SPLIT];
+        bool active[UPDATE_SPLIT];
+
+        // calculate next addresses
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            DATA_TYPE v = 0;
+            if (((DATA_TYPE) ran) < 0) {
+                v = POLY;
+            }
+            ran = (ran << 1) ^ v;
+            update_val[ld] = ran;
+            local_address[ld] = DISTRIBUTE_ADDRESS(ran, ran & (m - 1))
+                                - address_start;
+            active[ld] = local_address[ld] < chunk_size;
+        }
+
+        // apply the updates of cached entries in their original order
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            if (active[ld] && local_address[ld] < cached_size) {
+                #if OPERATION == OPERATION_GATHER
+                local_checksum ^= cache[local_address[ld]];
+                #else
+                ENTRY_TYPE const cached = cache[local_address[ld]];
+                STORE_UPDATE(cache, local_address[ld], cached,
+                             update_val[ld], local_address[ld] + address_start);
+                #endif
+                active[ld] = false;
+            }
+        }
+
+        // load the data of the calculated addresses from global memory
+        #if OPERATION != OPERATION_SCATTER
+        #pragma unroll GLOBAL_MEM_UNROLL
+        #pragma ivdep array(data)
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            if (active[ld]) {
+                loaded_data[ld] = data[local_address[ld]];
+            }
+        }
+        #endif
+
+        #if OPERATION == OPERATION_GATHER
+        // accumulate the loaded data instead of storing it back
+        #pragma unroll GLOBAL_MEM_UNROLL
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            if (active[ld]) {
+                local_checksum ^= loaded_data[ld];
+            }
+        }
+        #else
+        // store back the calculated addresses from global memory
+        #pragma unroll GLOBAL_MEM_UNROLL
+        #pragma ivdep array(data)
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            if (active[ld]) {
+                STORE_UPDATE(data, local_address[ld], loaded_data[ld],
+                             update_val[ld], local_address[ld] + address_start);
+            }
+        }
+        #endif
+    }
+
+    #if OPERATION == OPERATION_GATHER
+    checksum[0] = local_checksum;
+    #else
+    // write back the cached entries
+    #pragma unroll GLOBAL_MEM_UNROLL
+    for (DATA_TYPE_UNSIGNED c=0; c < cached_size; c++) {
+        data[c] = cache[c];
+    }
+    #endif
+}
+// PY_CODE_GEN block_end [replace(replace_dict=locals()) for repl in range(replications)]
+
+// PY_CODE_GEN block_start
+#include "random_access_auxiliary_kernels_$replications$.cl"
+// PY_CODE_GEN block_end replace()
@@ -0,0 +1,248 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "random_access_kernels_common.h"
+
+// PY_CODE_GEN block_start
+#define SINGLE_KERNEL
+// PY_CODE_GEN block_end if_cond(replications == 1, CODE, None)
+
+/*
+The size of the local memory buffer.
+Multiple updates to the same address within this range are merged before
+they are stored, so it can be chosen bigger than for the single kernel.
+*/
+#ifndef UPDATE_SPLIT
+#define UPDATE_SPLIT 1024
+#endif
+
+/*
+Number of sets of the tag store that detects multiple updates to the same
+address within a batch. Has to be a power of two. Every set can track
+TAG_STORE_WAYS addresses of a batch. If a set is full, further addresses of
+the batch that map to it are not tracked, so their updates may still be lost.
+*/
+#ifndef TAG_STORE_SIZE
+#define TAG_STORE_SIZE (2 * UPDATE_SPLIT)
+#endif
+
+#ifndef TAG_STORE_WAYS
+#define TAG_STORE_WAYS 4
+#endif
+
+/*
+Number of parts of the address of TAG_STORE_SIZE items that are XORed to get
+the set of the address. Consecutive addresses of the update sequence only
+differ in a shift, so the low bits alone would map them to few sets.
+*/
+#define TAG_STORE_FOLDS 4
+
+/*
+Kernel, that will update the given data array accoring to a predefined pseudo-
+random access scheme. The overall data array might be equally split between
+multiple kernels. In that case, the index of the current split can be given
+to the kernel.
+Updates to the same address within a batch are detected with a tag store in
+local memory and forwarded to the first update of the address, so the loads
+and stores of a batch never overlap.
+
+@param data The data array that will be updated
+@param m The size of the data array
+@param data_chunk The chunk index that has to be updated by the kernel
+@param checksum Only for GATHER: XOR of all loaded values
+@param block_table Only for ADDRESS_DISTRIBUTION: block of every slot of the
+        address distribution
+*/
+// PY_CODE_GEN block_start
+__attribute__((max_global_work_dim(0)))
+__kernel
+void accessMemory$repl$(__global volatile ENTRY_TYPE* restrict data,
+                        DATA_TYPE_UNSIGNED m,
+                        DATA_TYPE_UNSIGNED data_chunk
+#if OPERATION == OPERATION_GATHER
+                        , __global ENTRY_TYPE* restrict checksum
+#endif
+#ifdef ADDRESS_DISTRIBUTION
+                        , __global const uint* restrict block_table
+#endif
+                        ) {
+    // Initiate the pseudo random number
+    DATA_TYPE_UNSIGNED ran = 1;
+
+    // calculate the start of the address range this kernel is responsible for
+    #ifndef SINGLE_KERNEL
+    DATA_TYPE_UNSIGNED const address_start = $repl$ * data_chunk;
+    #else
+    DATA_TYPE_UNSIGNED const address_start = 0;
+    #endif
+
+    DATA_TYPE_UNSIGNED const mupdate = 4 * m;
+    ENTRY_TYPE local_checksum = 0;
+
+    #ifdef ADDRESS_DISTRIBUTION
+    // copy the block table to local memory and calculate the number of
+    // address bits within a segment, within a block and of the data array
+    uint local_block_table[DISTRIBUTION_SLOTS];
+    for (int s=0; s < DISTRIBUTION_SLOTS; s++) {
+        local_block_table[s] = block_table[s];
+    }
+    int segment_shift = 0;
+    while (((DATA_TYPE_UNSIGNED) DISTRIBUTION_SLOTS << segment_shift) < m) {
+        segment_shift++;
+    }
+    int block_shift = segment_shift;
+    while (((DATA_TYPE_UNSIGNED) DISTRIBUTION_BLOCKS << block_shift) < m) {
+        block_shift++;
+    }
+    int address_bits = block_shift;
+    while (((DATA_TYPE_UNSIGNED) 1 << address_bits) < m) {
+        address_bits++;
+    }
+    DATA_TYPE_UNSIGNED const segment_offset_mask =
+                                ((DATA_TYPE_UNSIGNED) 1 << segment_shift) - 1;
+    #endif
+
+    #if OPERATION != OPERATION_GATHER
+    // The tag store maps an address to the first update of the address in
+    // the batch. Entries are valid if they contain the number of the
+    // current batch, so they do not have to be cleared for every batch.
+    DATA_TYPE_UNSIGNED tag_address[TAG_STORE_SIZE][TAG_STORE_WAYS];
+    DATA_TYPE_UNSIGNED tag_batch[TAG_STORE_SIZE][TAG_STORE_WAYS];
+    int tag_update[TAG_STORE_SIZE][TAG_STORE_WAYS];
+    for (int t=0; t < TAG_STORE_SIZE; t++) {
+        #pragma unroll
+        for (int w=0; w < TAG_STORE_WAYS; w++) {
+            tag_batch[t][w] = 0;
+        }
+    }
+    #endif
+
+    // do random accesses
+    for (DATA_TYPE_UNSIGNED i=0; i< mupdate / UPDATE_SPLIT; i++) {
+
+        DATA_TYPE_UNSIGNED local_address[UPDATE_SPLIT];
+        ENTRY_TYPE loaded_data[UPDATE_SPLIT];
+        DATA_TYPE_UNSIGNED update_val[UPDATE_SPLIT];
+        bool active[UPDATE_SPLIT];
+
+        // calculate next addresses
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            DATA_TYPE v = 0;
+            if (((DATA_TYPE) ran) < 0) {
+                v = POLY;
+            }
+            ran = (ran << 1) ^ v;
+            update_val[ld] = ran;
+            DATA_TYPE_UNSIGNED address =
+                                    DISTRIBUTE_ADDRESS(ran, ran & (m - 1));
+            #ifndef SINGLE_KERNEL
+            local_address[ld] = address - address_start;
+            active[ld] = local_address[ld] < data_chunk;
+            #else
+            local_address[ld] = address;
+            active[ld] = true;
+            #endif
+        }
+
+        #if OPERATION != OPERATION_GATHER
+        // forward updates to addresses that are already updated in the batch
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            if (active[ld]) {
+                DATA_TYPE_UNSIGNED folded = 0;
+                DATA_TYPE_UNSIGNED rest = local_address[ld];
+                #pragma unroll
+                for (int f=0; f < TAG_STORE_FOLDS; f++) {
+                    folded ^= rest;
+                    rest /= TAG_STORE_SIZE;
+                }
+                int const set = folded & (TAG_STORE_SIZE - 1);
+
+                // compare the address with all ways of the set in parallel
+                int hit = -1;
+                int empty = -1;
+                #pragma unroll
+                for (int w=0; w < TAG_STORE_WAYS; w++) {
+                    if (tag_batch[set][w] == i + 1) {
+                        if (tag_address[set][w] == local_address[ld]) {
+                            hit = w;
+                        }
+                    } else if (empty < 0) {
+                        empty = w;
+                    }
+                }
+                if (hit >= 0) {
+                    int const first = tag_update[set][hit];
+                    update_val[first] = MERGE_UPDATE(update_val[first],
+                                            update_val[ld],
+                                            local_address[ld] + address_start);
+                    active[ld] = false;
+                } else if (empty >= 0) {
+                    tag_batch[set][empty] = i + 1;
+                    tag_address[set][empty] = local_address[ld];
+                    tag_update[set][empty] = ld;
+                }
+            }
+        }
+        #endif
+
+        // load the data of the calculated addresses from global memory
+        #if OPERATION != OPERATION_SCATTER
+        #pragma unroll GLOBAL_MEM_UNROLL
+        #pragma ivdep array(data)
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            if (active[ld]) {
+                loaded_data[ld] = data[local_address[ld]];
+            }
+        }
+        #endif
+
+        #if OPERATION == OPERATION_GATHER
+        // accumulate the loaded data instead of storing it back
+        #pragma unroll GLOBAL_MEM_UNROLL
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            if (active[ld]) {
+                local_checksum ^= loaded_data[ld];
+            }
+        }
+        #else
+        // store back the calculated addresses from global memory. The
+        // addresses of the active updates are unique within the batch.
+        #pragma unroll GLOBAL_MEM_UNROLL
+        #pragma ivdep array(data)
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            if (active[ld]) {
+                STORE_UPDATE(data, local_address[ld], loaded_data[ld],
+                             update_val[ld], local_address[ld] + address_start);
+            }
+        }
+        #endif
+    }
+
+    #if OPERATION == OPERATION_GATHER
+    checksum[0] = local_checksum;
+    #endif
+}
+// PY_CODE_GEN block_end [replace(replace_dict=locals()) for repl in range(replications)]
+
+// PY_CODE_GEN block_start
+#include "random_access_auxiliary_kernels_$replications$.cl"
+// PY_CODE_GEN block_end replace()
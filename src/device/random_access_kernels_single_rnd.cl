@@ -20,31 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-/*
-The data type used for the data array.
-*/
-#ifndef DATA_TYPE
-#define DATA_TYPE long
-#endif
-
-/*
-Unsigned version of the data type used for the data array.
-*/
-#ifndef DATA_TYPE_UNSIGNED
-#define DATA_TYPE_UNSIGNED ulong
-#endif
-
-/*
-Unrolling factor for the read and write pipelines of each kernel.
-*/
-#ifndef GLOBAL_MEM_UNROLL
-#define GLOBAL_MEM_UNROLL 4
-#endif
-
-/*
-Constant used to update the pseudo random number
-*/
-#define POLY 7
+#include "random_access_kernels_common.h"
 
 // PY_CODE_GEN block_start
 #define SINGLE_KERNEL
@@ -70,13 +46,18 @@ to the kernel.
     multiple addresses
 @param m The size of the data array
 @param data_chunk The chunk index that has to be updated by the kernel
+@param checksum Only for GATHER: XOR of all loaded values
 */
 // PY_CODE_GEN block_start
 __kernel
-void accessMemory$repl$(__global volatile DATA_TYPE_UNSIGNED* restrict data,
+void accessMemory$repl$(__global volatile ENTRY_TYPE* restrict data,
                         __global DATA_TYPE_UNSIGNED* restrict random,
                         DATA_TYPE_UNSIGNED m,
-                        DATA_TYPE_UNSIGNED data_chunk) {
+                        DATA_TYPE_UNSIGNED data_chunk
+#if OPERATION == OPERATION_GATHER
+                        , __global ENTRY_TYPE* restrict checksum
+#endif
+                        ) {
 
     DATA_TYPE_UNSIGNED local_random[UPDATE_SPLIT];
     #pragma unroll GLOBAL_MEM_UNROLL
@@ -87,16 +68,19 @@ void accessMemory$repl$(__global volatile DATA_TYPE_UNSIGNED* restrict data,
     // calculate the start of the address range this kernel is responsible for
     #ifndef SINGLE_KERNEL
     DATA_TYPE_UNSIGNED const address_start = $repl$ * data_chunk;
+    #else
+    DATA_TYPE_UNSIGNED const address_start = 0;
     #endif
 
     DATA_TYPE_UNSIGNED const mupdate = 4 * m;
+    ENTRY_TYPE local_checksum = 0;
 
     // do random accesses
     #pragma ivdep
     for (DATA_TYPE_UNSIGNED i=0; i< mupdate / UPDATE_SPLIT; i++) {
 
         DATA_TYPE_UNSIGNED local_address[UPDATE_SPLIT];
-        DATA_TYPE_UNSIGNED loaded_data[UPDATE_SPLIT];
+        ENTRY_TYPE loaded_data[UPDATE_SPLIT];
         DATA_TYPE_UNSIGNED writeback_data[UPDATE_SPLIT];
         DATA_TYPE_UNSIGNED update_val[UPDATE_SPLIT];
 
@@ -118,6 +102,7 @@ void accessMemory$repl$(__global volatile DATA_TYPE_UNSIGNED* restrict data,
         }
 
         // load the data of the calculated addresses from global memory
+        #if OPERATION != OPERATION_SCATTER
         #pragma unroll GLOBAL_MEM_UNROLL
         #pragma ivdep
         for (int ld=0; ld< UPDATE_SPLIT; ld++) {
@@ -129,19 +114,43 @@ void accessMemory$repl$(__global volatile DATA_TYPE_UNSIGNED* restrict data,
             }
             #endif
         }
+        #endif
 
+        #if OPERATION == OPERATION_GATHER
+        // accumulate the loaded data instead of storing it back
+        #pragma unroll GLOBAL_MEM_UNROLL
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            #ifndef SINGLE_KERNEL
+            if (local_address[ld] < data_chunk)
+            #endif
+            {
+                local_checksum ^= loaded_data[ld];
+            }
+        }
+        #else
         // store back the calculated addresses from global memory
         #pragma unroll GLOBAL_MEM_UNROLL
         #pragma ivdep
         for (int ld=0; ld< UPDATE_SPLIT; ld++) {
             #ifdef SINGLE_KERNEL
-            data[local_address[ld]] = loaded_data[ld] ^update_val[ld];
+            STORE_UPDATE(data, local_address[ld], loaded_data[ld],
+                         update_val[ld], local_address[ld]);
             #else
             if (local_address[ld] < data_chunk) {
-                data[local_address[ld]] = loaded_data[ld] ^ update_val[ld];
+                STORE_UPDATE(data, local_address[ld], loaded_data[ld],
+                             update_val[ld], local_address[ld] + address_start);
             }
             #endif
         }
+        #endif
     }
+
+    #if OPERATION == OPERATION_GATHER
+    checksum[0] = local_checksum;
+    #endif
 }
 // PY_CODE_GEN block_end [replace(replace_dict=locals()) for repl in range(replications)]
+
+// PY_CODE_GEN block_start
+#include "random_access_auxiliary_kernels_$replications$.cl"
+// PY_CODE_GEN block_end replace()
@@ -0,0 +1,236 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "random_access_kernels_common.h"
+
+// PY_CODE_GEN block_start
+#define SINGLE_KERNEL
+// PY_CODE_GEN block_end if_cond(replications == 1, CODE, None)
+
+/*
+The size of the local memory buffer.
+The updates of a batch of this size are sorted by their address and updates
+to the same address are merged, so it can be chosen bigger than for the
+single kernel without errors.
+*/
+#ifndef UPDATE_SPLIT
+#define UPDATE_SPLIT 1024
+#endif
+
+/*
+Number of address bits that are sorted in a pass of the radix sort
+*/
+#ifndef SORT_RADIX_BITS
+#define SORT_RADIX_BITS 8
+#endif
+
+#define SORT_BINS (1 << SORT_RADIX_BITS)
+
+/*
+Kernel, that will update the given data array accoring to a predefined pseudo-
+random access scheme. The overall data array might be equally split between
+multiple kernels. In that case, the index of the current split can be given
+to the kernel.
+The updates of a batch are sorted by their address with a stable radix sort
+in local memory before the data is loaded, so accesses to the same DRAM row
+are issued after each other. Updates to the same address are adjacent after
+the sort and merged in their original order.
+
+@param data The data array that will be updated
+@param m The size of the data array
+@param data_chunk The chunk index that has to be updated by the kernel
+@param checksum Only for GATHER: XOR of all loaded values
+@param block_table Only for ADDRESS_DISTRIBUTION: block of every slot of the
+        address distribution
+*/
+// PY_CODE_GEN block_start
+__attribute__((max_global_work_dim(0)))
+__kernel
+void accessMemory$repl$(__global volatile ENTRY_TYPE* restrict data,
+                        DATA_TYPE_UNSIGNED m,
+                        DATA_TYPE_UNSIGNED data_chunk
+#if OPERATION == OPERATION_GATHER
+                        , __global ENTRY_TYPE* restrict checksum
+#endif
+#ifdef ADDRESS_DISTRIBUTION
+                        , __global const uint* restrict block_table
+#endif
+                        ) {
+    // Initiate the pseudo random number
+    DATA_TYPE_UNSIGNED ran = 1;
+
+    // calculate the start of the address range this kernel is responsible for
+    #ifndef SINGLE_KERNEL
+    DATA_TYPE_UNSIGNED const address_start = $repl$ * data_chunk;
+    DATA_TYPE_UNSIGNED const chunk_size = data_chunk;
+    #else
+    DATA_TYPE_UNSIGNED const address_start = 0;
+    DATA_TYPE_UNSIGNED const chunk_size = m;
+    #endif
+
+    DATA_TYPE_UNSIGNED const mupdate = 4 * m;
+    ENTRY_TYPE local_checksum = 0;
+
+    #ifdef ADDRESS_DISTRIBUTION
+    // copy the block table to local memory and calculate the number of
+    // address bits within a segment, within a block and of the data array
+    uint local_block_table[DISTRIBUTION_SLOTS];
+    for (int s=0; s < DISTRIBUTION_SLOTS; s++) {
+        local_block_table[s] = block_table[s];
+    }
+    int segment_shift = 0;
+    while (((DATA_TYPE_UNSIGNED) DISTRIBUTION_SLOTS << segment_shift) < m) {
+        segment_shift++;
+    }
+    int block_shift = segment_shift;
+    while (((DATA_TYPE_UNSIGNED) DISTRIBUTION_BLOCKS << block_shift) < m) {
+        block_shift++;
+    }
+    int address_bits = block_shift;
+    while (((DATA_TYPE_UNSIGNED) 1 << address_bits) < m) {
+        address_bits++;
+    }
+    DATA_TYPE_UNSIGNED const segment_offset_mask =
+                                ((DATA_TYPE_UNSIGNED) 1 << segment_shift) - 1;
+    #endif
+
+    // number of radix sort passes needed for the addresses of the chunk
+    int passes = 0;
+    while (((chunk_size - 1) >> (passes * SORT_RADIX_BITS)) > 0) {
+        passes++;
+    }
+
+    // do random accesses
+    for (DATA_TYPE_UNSIGNED i=0; i< mupdate / UPDATE_SPLIT; i++) {
+
+        // the sort alternates between both halves of the buffers
+        DATA_TYPE_UNSIGNED sort_address[2][UPDATE_SPLIT];
+        DATA_TYPE_UNSIGNED sort_value[2][UPDATE_SPLIT];
+        ENTRY_TYPE loaded_data[UPDATE_SPLIT];
+        int bin_start[SORT_BINS];
+
+        // calculate next addresses and keep the ones of this chunk
+        int count = 0;
+        for (int ld=0; ld< UPDATE_SPLIT; ld++) {
+            DATA_TYPE v = 0;
+            if (((DATA_TYPE) ran) < 0) {
+                v = POLY;
+            }
+            ran = (ran << 1) ^ v;
+            DATA_TYPE_UNSIGNED local_address =
+                    DISTRIBUTE_ADDRESS(ran, ran & (m - 1)) - address_start;
+            if (local_address < chunk_size) {
+                sort_address[0][count] = local_address;
+                sort_value[0][count] = ran;
+                count++;
+            }
+        }
+
+        // sort the updates by their address
+        for (int p=0; p < passes; p++) {
+            int const in = p & 1;
+            int const out = 1 - in;
+            int const shift = p * SORT_RADIX_BITS;
+            #pragma unroll
+            for (int b=0; b < SORT_BINS; b++) {
+                bin_start[b] = 0;
+            }
+            for (int k=0; k < count; k++) {
+                bin_start[(sort_address[in][k] >> shift) & (SORT_BINS - 1)]++;
+            }
+            int offset = 0;
+            for (int b=0; b < SORT_BINS; b++) {
+                int const size = bin_start[b];
+                bin_start[b] = offset;
+                offset += size;
+            }
+            for (int k=0; k < count; k++) {
+                int const bin = (sort_address[in][k] >> shift)
+                                    & (SORT_BINS - 1);
+                int const position = bin_start[bin];
+                bin_start[bin] = position + 1;
+                sort_address[out][position] = sort_address[in][k];
+                sort_value[out][position] = sort_value[in][k];
+            }
+        }
+        int const sorted = passes & 1;
+
+        #if OPERATION != OPERATION_GATHER
+        // merge updates to the same address
+        int unique = 0;
+        for (int k=0; k < count; k++) {
+            if (unique > 0
+                    && sort_address[sorted][unique - 1]
+                        == sort_address[sorted][k]) {
+                DATA_TYPE_UNSIGNED const address = sort_address[sorted][k]
+                                                    + address_start;
+                sort_value[sorted][unique - 1] = MERGE_UPDATE(
+                                                sort_value[sorted][unique - 1],
+                                                sort_value[sorted][k],
+                                                address);
+            } else {
+                sort_address[sorted][unique] = sort_address[sorted][k];
+                sort_value[sorted][unique] = sort_value[sorted][k];
+                unique++;
+            }
+        }
+        #else
+        int const unique = count;
+        #endif
+
+        // load the data of the sorted addresses from global memory
+        #if OPERATION != OPERATION_SCATTER
+        #pragma unroll GLOBAL_MEM_UNROLL
+        #pragma ivdep array(data)
+        for (int k=0; k < unique; k++) {
+            loaded_data[k] = data[sort_address[sorted][k]];
+        }
+        #endif
+
+        #if OPERATION == OPERATION_GATHER
+        // accumulate the loaded data instead of storing it back
+        #pragma unroll GLOBAL_MEM_UNROLL
+        for (int k=0; k < unique; k++) {
+            local_checksum ^= loaded_data[k];
+        }
+        #else
+        // store back the calculated addresses from global memory. The
+        // addresses are unique within the batch.
+        #pragma unroll GLOBAL_MEM_UNROLL
+        #pragma ivdep array(data)
+        for (int k=0; k < unique; k++) {
+            STORE_UPDATE(data, sort_address[sorted][k], loaded_data[k],
+                         sort_value[sorted][k],
+                         sort_address[sorted][k] + address_start);
+        }
+        #endif
+    }
+
+    #if OPERATION == OPERATION_GATHER
+    checksum[0] = local_checksum;
+    #endif
+}
+// PY_CODE_GEN block_end [replace(replace_dict=locals()) for repl in range(replications)]
+
+// PY_CODE_GEN block_start
+#include "random_access_auxiliary_kernels_$replications$.cl"
+// PY_CODE_GEN block_end replace()
@@ -0,0 +1,296 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/address_distribution.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/random_access_definitions.h"
+
+namespace bm_distribution {
+
+/*
+Parses the bank bias into a weight for every replication
+*/
+static std::vector<double>
+parseBankBias(std::string const &bankBias, uint replications) {
+    if (bankBias.empty()) {
+        return std::vector<double>(replications, 1.0);
+    }
+    std::vector<double> weights;
+    std::stringstream list(bankBias);
+    std::string weight;
+    double sum = 0;
+    while (std::getline(list, weight, ',')) {
+        char* end;
+        double value = strtod(weight.c_str(), &end);
+        if (weight.empty() || *end != '\0' || value < 0) {
+            throw std::runtime_error("Unknown bank bias " + bankBias);
+        }
+        weights.push_back(value);
+        sum += value;
+    }
+    if (weights.size() != replications || sum <= 0) {
+        throw std::runtime_error("The bank bias has to contain a weight for "
+                                 "each of the "
+                                 + std::to_string(replications)
+                                 + " replications");
+    }
+    return weights;
+}
+
+/*
+ @copydoc bm_distribution::isDistribution()
+*/
+bool
+isDistribution(std::string const &name) {
+    return name == "uniform" || name == "zipf" || name == "hotset";
+}
+
+/*
+ @copydoc bm_distribution::createBlockTable()
+*/
+std::vector<cl_uint>
+createBlockTable(std::string const &name, double zipfExponent,
+                 double hotFraction, double hotProbability,
+                 std::string const &bankBias, uint replications) {
+    if (replications == 0 || DISTRIBUTION_BLOCKS % replications != 0) {
+        throw std::runtime_error("The "
+                                 + std::to_string(DISTRIBUTION_BLOCKS)
+                                 + " blocks of the distribution can not be "
+                                 "split into " + std::to_string(replications)
+                                 + " replications");
+    }
+    if (DISTRIBUTION_SLOTS % DISTRIBUTION_BLOCKS != 0) {
+        throw std::runtime_error("The " + std::to_string(DISTRIBUTION_SLOTS)
+                                 + " slots of the block table can not be "
+                                 "split into "
+                                 + std::to_string(DISTRIBUTION_BLOCKS)
+                                 + " blocks");
+    }
+    if (zipfExponent < 0 || hotFraction <= 0 || hotFraction > 1
+            || hotProbability < 0 || hotProbability > 1) {
+        throw std::runtime_error("Invalid parameters of the distribution "
+                                 + name);
+    }
+    std::vector<double> bias = parseBankBias(bankBias, replications);
+    size_t const blocksPerChunk = DISTRIBUTION_BLOCKS / replications;
+    size_t const hotBlocks = std::max<size_t>(1,
+                            std::llround(hotFraction * DISTRIBUTION_BLOCKS));
+
+    std::vector<double> weights(DISTRIBUTION_BLOCKS);
+    double sum = 0;
+    for (size_t b = 0; b < DISTRIBUTION_BLOCKS; b++) {
+        size_t const chunk = b / blocksPerChunk;
+        size_t const rank = (b % blocksPerChunk) * replications + chunk;
+        double weight = 1.0;
+        if (name == "zipf") {
+            weight = std::pow(rank + 1.0, -zipfExponent);
+        } else if (name == "hotset" && hotBlocks < DISTRIBUTION_BLOCKS) {
+            weight = (rank < hotBlocks)
+                    ? hotProbability / hotBlocks
+                    : (1.0 - hotProbability)
+                        / (DISTRIBUTION_BLOCKS - hotBlocks);
+        }
+        weights[b] = weight * bias[chunk];
+        sum += weights[b];
+    }
+
+    // Assign the slots with the largest remainder method, so the number of
+    // slots of every block is as close to its weight as possible
+    std::vector<size_t> slots(DISTRIBUTION_BLOCKS);
+    std::vector<std::pair<double, size_t>> remainders;
+    size_t assigned = 0;
+    for (size_t b = 0; b < DISTRIBUTION_BLOCKS; b++) {
+        double exact = weights[b] / sum * DISTRIBUTION_SLOTS;
+        slots[b] = static_cast<size_t>(exact);
+        assigned += slots[b];
+        remainders.push_back({slots[b] - exact, b});
+    }
+    std::sort(remainders.begin(), remainders.end());
+    for (size_t k = 0; assigned < DISTRIBUTION_SLOTS; k++, assigned++) {
+        slots[remainders[k].second]++;
+    }
+
+    std::vector<cl_uint> table;
+    for (size_t b = 0; b < DISTRIBUTION_BLOCKS; b++) {
+        table.insert(table.end(), slots[b], static_cast<cl_uint>(b));
+    }
+    // The uniform table maps every segment to its own block
+    if (table == deviceBlockTable(std::vector<cl_uint>())) {
+        table.clear();
+    }
+    return table;
+}
+
+/*
+ @copydoc bm_distribution::deviceBlockTable()
+*/
+std::vector<cl_uint>
+deviceBlockTable(std::vector<cl_uint> const &table) {
+    if (!table.empty()) {
+        return table;
+    }
+    size_t const segmentsPerBlock = DISTRIBUTION_SLOTS / DISTRIBUTION_BLOCKS;
+    std::vector<cl_uint> identity(DISTRIBUTION_SLOTS);
+    for (size_t s = 0; s < DISTRIBUTION_SLOTS; s++) {
+        identity[s] = s / segmentsPerBlock;
+    }
+    return identity;
+}
+
+/*
+ @copydoc bm_distribution::describeDistribution()
+*/
+std::string
+describeDistribution(std::string const &name, double zipfExponent,
+                     double hotFraction, double hotProbability,
+                     std::string const &bankBias,
+                     std::vector<cl_uint> const &table) {
+    std::stringstream description;
+    description << name;
+    if (name == "zipf") {
+        description << " (s = " << zipfExponent << ")";
+    } else if (name == "hotset") {
+        description << " (" << 100 * hotProbability << "% of the updates to "
+                    << 100 * hotFraction << "% of the entries)";
+    }
+    if (!bankBias.empty()) {
+        description << ", bank bias " << bankBias;
+    }
+    // Blocks without a slot are never updated
+    std::vector<bool> updated(DISTRIBUTION_BLOCKS, false);
+    for (cl_uint block : deviceBlockTable(table)) {
+        updated[block] = true;
+    }
+    size_t untouched = std::count(updated.begin(), updated.end(), false);
+    if (untouched > 0) {
+        description << ", " << 100.0 * untouched / DISTRIBUTION_BLOCKS
+                    << "% of the entries not updated";
+    }
+    return description.str();
+}
+
+/*
+ @copydoc bm_distribution::cachedFraction()
+*/
+double
+cachedFraction(std::vector<cl_uint> const &table, size_t dataSize,
+               uint replications, size_t cacheSize) {
+    std::vector<cl_uint> const slots = deviceBlockTable(table);
+    size_t const chunkSize = dataSize / replications;
+    size_t const cachedSize = std::min(cacheSize, chunkSize);
+    double const blockSize = static_cast<double>(dataSize)
+                                / DISTRIBUTION_BLOCKS;
+    double cached = 0;
+    for (cl_uint block : slots) {
+        // Every slot covers a block with the same probability
+        double const start = block * blockSize;
+        double const chunkStart = std::floor(start / chunkSize) * chunkSize;
+        double const end = std::min(start + blockSize,
+                                    chunkStart + cachedSize);
+        cached += std::max(0.0, end - start) / blockSize;
+    }
+    return cached / slots.size();
+}
+
+/*
+ @copydoc bm_distribution::chunkFractions()
+*/
+std::vector<double>
+chunkFractions(std::vector<cl_uint> const &table, size_t dataSize,
+               uint replications) {
+    std::vector<cl_uint> const slots = deviceBlockTable(table);
+    size_t const chunkSize = dataSize / replications;
+    double const blockSize = static_cast<double>(dataSize)
+                                / DISTRIBUTION_BLOCKS;
+    std::vector<double> fractions(replications, 0);
+    for (cl_uint block : slots) {
+        // Every slot covers a block with the same probability, which may
+        // overlap multiple chunks if the blocks are larger than the chunks
+        double start = block * blockSize;
+        double const end = start + blockSize;
+        while (start < end) {
+            size_t const chunk = std::min(
+                        static_cast<size_t>(start / chunkSize),
+                        static_cast<size_t>(replications - 1));
+            double const chunkEnd = (chunk == replications - 1)
+                        ? end : std::min(end, (chunk + 1.0) * chunkSize);
+            fractions[chunk] += (chunkEnd - start) / blockSize;
+            start = chunkEnd;
+        }
+    }
+    for (double &fraction : fractions) {
+        fraction /= slots.size();
+    }
+    return fractions;
+}
+
+/*
+ @copydoc bm_distribution::AddressMap::AddressMap()
+*/
+AddressMap::AddressMap(size_t dataSize, std::vector<cl_uint> const &table)
+        : blocks(table.empty() ? nullptr : table.data()),
+          mask(dataSize - 1), segmentShift(0), blockShift(0), addressBits(0),
+          segmentMask(DISTRIBUTION_SLOTS / DISTRIBUTION_BLOCKS - 1),
+          offsetMask(0) {
+    if (blocks == nullptr) {
+        return;
+    }
+    if (dataSize < DISTRIBUTION_SLOTS) {
+        throw std::runtime_error("The data array needs at least "
+                                 + std::to_string(DISTRIBUTION_SLOTS)
+                                 + " entries for the address distribution");
+    }
+    while ((static_cast<size_t>(DISTRIBUTION_SLOTS) << segmentShift)
+                                                            < dataSize) {
+        segmentShift++;
+    }
+    blockShift = segmentShift;
+    while ((static_cast<size_t>(DISTRIBUTION_BLOCKS) << blockShift)
+                                                            < dataSize) {
+        blockShift++;
+    }
+    addressBits = blockShift;
+    while ((static_cast<size_t>(1) << addressBits) < dataSize) {
+        addressBits++;
+    }
+    // The segment within a block is selected with the bits above the address
+    if (addressBits + blockShift - segmentShift > BIT_SIZE) {
+        throw std::runtime_error("The random numbers have not enough bits to "
+                                 "select the segments of the address "
+                                 "distribution");
+    }
+    offsetMask = (static_cast<DATA_TYPE_UNSIGNED>(1) << segmentShift) - 1;
+}
+
+}  // namespace bm_distribution
@@ -0,0 +1,222 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_ADDRESS_DISTRIBUTION_H_
+#define SRC_HOST_ADDRESS_DISTRIBUTION_H_
+
+/* C++ standard library headers */
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/random_access_definitions.h"
+
+/**
+Number of equally sized blocks the data array is split into for the address
+distributions. The blocks are ranked and get a probability given by the
+distribution. Has to be a power of two and the same as in the used kernels.
+*/
+#ifndef DISTRIBUTION_BLOCKS
+#define DISTRIBUTION_BLOCKS 4096
+#endif
+
+/**
+Number of slots of the block table. The data array is split into the same
+number of equally sized segments. Every update selects a slot with the
+segment of its uniform address and is moved to the block stored in the slot,
+so the probability of a block is a multiple of 1 / DISTRIBUTION_SLOTS.
+Has to be a power of two multiple of DISTRIBUTION_BLOCKS and the same as in
+the used kernels.
+*/
+#ifndef DISTRIBUTION_SLOTS
+#define DISTRIBUTION_SLOTS (16 * DISTRIBUTION_BLOCKS)
+#endif
+
+/**
+Contains the skewed address distributions of the updates. The distribution is
+described by a table with a slot for every block of the data array. The
+table is part of the configuration of a run, so the kernels, the functional
+model and the verification on the host calculate the same addresses.
+*/
+namespace bm_distribution {
+
+/**
+Checks if a distribution with the given name exists
+
+@param name The name of the distribution
+
+@return true, if the name is uniform, zipf or hotset
+*/
+bool
+isDistribution(std::string const &name);
+
+/**
+Creates the block table of a distribution.
+The blocks of the data chunks of all replications are ranked round-robin, so
+the first blocks of every chunk are the hottest ones and all chunks get the
+same share of the updates unless a bank bias is given:
+    - uniform: all blocks have the same probability
+    - zipf: the probability of the block with rank k is proportional to
+      1 / k^zipfExponent
+    - hotset: the hottest hotFraction of the blocks get hotProbability of
+      the updates
+The slots are assigned to the blocks in order, so the table of the uniform
+distribution would map every segment to its own block. It is returned empty
+instead, so the uniform addresses can be calculated without the table.
+
+@param name The name of the distribution
+@param zipfExponent The exponent s of the zipf distribution
+@param hotFraction Fraction of the blocks in the hot set
+@param hotProbability Fraction of the updates that go to the hot set
+@param bankBias Comma separated list with a weight for the chunk of every
+            replication (e.g. 4,1,1,1). If empty, all chunks have the same
+            weight.
+@param replications Number of replications the data array is split into
+
+@return The block table with DISTRIBUTION_SLOTS slots or an empty table
+        for the uniform distribution
+
+Throws std::runtime_error if the parameters of the distribution or the bank
+bias are invalid or the blocks can not be split into the replications.
+*/
+std::vector<cl_uint>
+createBlockTable(std::string const &name, double zipfExponent,
+                 double hotFraction, double hotProbability,
+                 std::string const &bankBias, uint replications);
+
+/**
+Expands a block table to the table that is written to the device
+
+@param table The block table as returned by createBlockTable()
+
+@return The block table with DISTRIBUTION_SLOTS slots. It maps every segment
+        to its own block if the given table is empty.
+*/
+std::vector<cl_uint>
+deviceBlockTable(std::vector<cl_uint> const &table);
+
+/**
+Describes a distribution for the summary of a run
+
+@param table The block table of the distribution
+
+@return The name of the distribution and its parameters, followed by the
+        fraction of the entries that are not updated because their block
+        has no slot in the block table
+*/
+std::string
+describeDistribution(std::string const &name, double zipfExponent,
+                     double hotFraction, double hotProbability,
+                     std::string const &bankBias,
+                     std::vector<cl_uint> const &table);
+
+/**
+Calculates the fraction of the updates that go to the cached entries at the
+start of the chunk of every replication
+
+@param table The block table of the distribution
+@param dataSize Number of entries in the data array
+@param replications Number of replications the data array is split into
+@param cacheSize Number of cached entries per replication
+
+@return The fraction of the updates to cached entries
+*/
+double
+cachedFraction(std::vector<cl_uint> const &table, size_t dataSize,
+               uint replications, size_t cacheSize);
+
+/**
+Calculates the fraction of the updates that go to the chunk of every
+replication
+
+@param table The block table of the distribution
+@param dataSize Number of entries in the data array
+@param replications Number of replications the data array is split into
+
+@return The fraction of the updates to the chunk of every replication
+*/
+std::vector<double>
+chunkFractions(std::vector<cl_uint> const &table, size_t dataSize,
+               uint replications);
+
+/**
+Maps the random numbers of the updates to the addresses of the entries for
+a block table and a data array of the given size
+*/
+class AddressMap {
+ public:
+    /**
+    Throws std::runtime_error if the data array is too small or too large
+    for the block table.
+
+    @param dataSize Number of entries in the data array. Has to be a power
+                    of two and at least DISTRIBUTION_SLOTS if the
+                    distribution is not uniform.
+    @param table The block table as returned by createBlockTable(). It is
+                    not copied and has to outlive the map.
+    */
+    AddressMap(size_t dataSize, std::vector<cl_uint> const &table);
+
+    /**
+    @return true, if the address of an update is its random number masked to
+            the size of the data array
+    */
+    bool
+    isUniform() const {
+        return blocks == nullptr;
+    }
+
+    /**
+    The segment within the block is selected with the random bits above the
+    address, so all entries of a block are updated.
+
+    @param ran The random number of the update
+
+    @return the address of the entry that is updated
+    */
+    DATA_TYPE_UNSIGNED
+    operator()(DATA_TYPE_UNSIGNED ran) const {
+        DATA_TYPE_UNSIGNED address = ran & mask;
+        if (blocks == nullptr) {
+            return address;
+        }
+        DATA_TYPE_UNSIGNED segment = (ran >> addressBits) & segmentMask;
+        return (static_cast<DATA_TYPE_UNSIGNED>(
+                                    blocks[address >> segmentShift])
+                                                            << blockShift)
+                | (segment << segmentShift)
+                | (address & offsetMask);
+    }
+
+ private:
+    cl_uint const* blocks;
+    DATA_TYPE_UNSIGNED mask;
+    int segmentShift;
+    int blockShift;
+    int addressBits;
+    DATA_TYPE_UNSIGNED segmentMask;
+    DATA_TYPE_UNSIGNED offsetMask;
+};
+
+}  // namespace bm_distribution
+
+#endif  // SRC_HOST_ADDRESS_DISTRIBUTION_H_
@@ -0,0 +1,398 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/address_trace.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/fpga_setup.h"
+#include "src/host/random_access_definitions.h"
+#include "src/host/trace.h"
+
+namespace bm_address_trace {
+
+/*
+Maximum number of bytes of a LEB128 varint of 64 bit
+*/
+#define MAX_VARINT_BYTES 10
+
+/*
+Writes a value as LEB128 varint and returns the position after it
+*/
+static inline uint8_t*
+writeVarint(uint8_t* position, uint64_t value) {
+    while (value >= 0x80) {
+        *position++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *position++ = static_cast<uint8_t>(value);
+    return position;
+}
+
+/*
+ @copydoc bm_address_trace::writeTrace()
+*/
+AddressTraceHeader
+writeTrace(std::string const &fileName, size_t dataSize,
+           std::vector<cl_uint> const &blockTable, size_t replications,
+           int64_t replication, size_t updateSplit) {
+    TRACE_SCOPE("write address trace");
+    bm_distribution::AddressMap addressOf(dataSize, blockTable);
+    bool filtered = replication != ADDRESS_TRACE_ALL_REPLICATIONS;
+    uint64_t chunkSize = dataSize / replications;
+    uint64_t updates = 4L * dataSize;
+    size_t maxFileSize = sizeof(AddressTraceHeader) + updates
+                            * (filtered ? 2 : 1) * MAX_VARINT_BYTES;
+
+    int file = open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0 || ftruncate(file, maxFileSize) != 0) {
+        if (file >= 0) {
+            close(file);
+        }
+        throw std::runtime_error("Could not create the trace file "
+                                 + fileName);
+    }
+    void* mapping = mmap(nullptr, maxFileSize, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, file, 0);
+    if (mapping == MAP_FAILED) {
+        close(file);
+        throw std::runtime_error("Could not map the trace file " + fileName);
+    }
+    uint8_t* payload = reinterpret_cast<uint8_t*>(mapping)
+                        + sizeof(AddressTraceHeader);
+    uint8_t* position = payload;
+
+    uint64_t accesses = 0;
+    uint64_t previousIndex = 0;
+    uint64_t previousAddress = 0;
+    DATA_TYPE_UNSIGNED ran = 1;
+    for (uint64_t i = 0; i < updates; i++) {
+        DATA_TYPE v = 0;
+        if (((DATA_TYPE) ran) < 0) {
+            v = POLY;
+        }
+        ran = (ran << 1) ^ v;
+        uint64_t address = addressOf(ran);
+        if (filtered) {
+            address -= replication * chunkSize;
+            if (address >= chunkSize) {
+                continue;
+            }
+            position = writeVarint(position, i - previousIndex);
+            previousIndex = i;
+        }
+        int64_t delta = static_cast<int64_t>(address - previousAddress);
+        position = writeVarint(position, (static_cast<uint64_t>(delta) << 1)
+                                         ^ static_cast<uint64_t>(delta >> 63));
+        previousAddress = address;
+        accesses++;
+    }
+
+    AddressTraceHeader header;
+    memcpy(header.magic, ADDRESS_TRACE_MAGIC, sizeof(header.magic));
+    header.version = ADDRESS_TRACE_VERSION;
+    header.hasIndices = filtered ? 1 : 0;
+    header.dataSize = dataSize;
+    header.replications = replications;
+    header.replication = replication;
+    header.updateSplit = updateSplit;
+    header.accesses = accesses;
+    header.payloadSize = position - payload;
+    memcpy(mapping, &header, sizeof(AddressTraceHeader));
+
+    munmap(mapping, maxFileSize);
+    int truncated = ftruncate(file, sizeof(AddressTraceHeader)
+                                    + header.payloadSize);
+    close(file);
+    if (truncated != 0) {
+        throw std::runtime_error("Could not truncate the trace file "
+                                 + fileName);
+    }
+    return header;
+}
+
+/*
+ @copydoc bm_address_trace::mapTrace()
+*/
+std::shared_ptr<MappedTrace>
+mapTrace(std::string const &fileName) {
+    int file = open(fileName.c_str(), O_RDONLY);
+    struct stat fileStat;
+    if (file < 0 || fstat(file, &fileStat) != 0) {
+        if (file >= 0) {
+            close(file);
+        }
+        throw std::runtime_error("Could not open the trace file "
+                                 + fileName);
+    }
+    size_t fileSize = fileStat.st_size;
+    if (fileSize < sizeof(AddressTraceHeader)) {
+        close(file);
+        throw std::runtime_error(fileName + " is no address trace");
+    }
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Could not map the trace file " + fileName);
+    }
+    // Sequential reads are announced to the kernel for a larger read ahead
+    madvise(mapping, fileSize, MADV_SEQUENTIAL);
+
+    AddressTraceHeader const* header =
+                        reinterpret_cast<AddressTraceHeader const*>(mapping);
+    if (memcmp(header->magic, ADDRESS_TRACE_MAGIC, sizeof(header->magic)) != 0
+        || header->version != ADDRESS_TRACE_VERSION
+        || sizeof(AddressTraceHeader) + header->payloadSize != fileSize) {
+        munmap(mapping, fileSize);
+        throw std::runtime_error(fileName + " is no address trace of version "
+                                 + std::to_string(ADDRESS_TRACE_VERSION));
+    }
+    return std::shared_ptr<MappedTrace>(
+        new MappedTrace {header, reinterpret_cast<uint8_t const*>(mapping)
+                                    + sizeof(AddressTraceHeader), fileSize},
+        [](MappedTrace* trace) {
+            munmap(const_cast<AddressTraceHeader*>(trace->header),
+                   trace->fileSize);
+            delete trace;
+        });
+}
+
+/*
+ @copydoc bm_address_trace::analyzeTrace()
+*/
+std::shared_ptr<AnalysisResults>
+analyzeTrace(MappedTrace const &trace, DRAMGeometry const &geometry) {
+    TRACE_SCOPE("analyze address trace");
+    std::shared_ptr<AnalysisResults> results(new AnalysisResults {0, 0, 0,
+                std::vector<size_t>(geometry.banks, 0),
+                std::vector<size_t>(geometry.banks, 0), 0, 0, 0, 0, 0, 0});
+    std::vector<int64_t> openRows(geometry.banks, -1);
+    std::vector<int64_t> sortedOpenRows(geometry.banks, -1);
+    uint64_t rowBytes = geometry.rowSize * geometry.banks;
+
+    auto access = [&](uint64_t address) {
+        uint64_t byte = address * geometry.itemSize;
+        uint64_t bank = (byte / geometry.rowSize) % geometry.banks;
+        int64_t row = byte / rowBytes;
+        results->accesses++;
+        results->bankAccesses[bank]++;
+        if (openRows[bank] == row) {
+            results->rowHits++;
+            results->bankRowHits[bank]++;
+        } else {
+            openRows[bank] = row;
+        }
+    };
+    auto sortedAccess = [&](uint64_t address) {
+        uint64_t byte = address * geometry.itemSize;
+        uint64_t bank = (byte / geometry.rowSize) % geometry.banks;
+        int64_t row = byte / rowBytes;
+        results->sortedAccesses++;
+        if (sortedOpenRows[bank] == row) {
+            results->sortedRowHits++;
+        } else {
+            sortedOpenRows[bank] = row;
+        }
+    };
+
+    std::vector<uint64_t> batch;
+    std::vector<uint64_t> sorted;
+    auto replayBatch = [&]() {
+        if (batch.empty()) {
+            return;
+        }
+        results->batches++;
+        if (geometry.operation != OPERATION_SCATTER) {
+            for (uint64_t address : batch) {
+                access(address);
+            }
+        }
+        if (geometry.operation != OPERATION_GATHER) {
+            for (uint64_t address : batch) {
+                access(address);
+            }
+        }
+
+        // Items that are updated more than once within a batch are loaded
+        // before the previous update is stored, so the update is lost
+        sorted = batch;
+        std::sort(sorted.begin(), sorted.end());
+        size_t collisions = 0;
+        for (size_t k = 1; k < sorted.size(); k++) {
+            if (sorted[k] == sorted[k - 1]) {
+                collisions++;
+            } else if (sorted[k] * geometry.itemSize / geometry.burstSize
+                    == sorted[k - 1] * geometry.itemSize / geometry.burstSize) {
+                results->sharedBursts++;
+            }
+        }
+        results->collisions += collisions;
+        if (collisions > 0) {
+            results->batchesWithCollisions++;
+        }
+
+        // Replay the batch like the single_sorted kernel, which merges the
+        // updates to the same address after the sort
+        if (geometry.operation != OPERATION_GATHER) {
+            sorted.erase(std::unique(sorted.begin(), sorted.end()),
+                         sorted.end());
+        }
+        if (geometry.operation != OPERATION_SCATTER) {
+            for (uint64_t address : sorted) {
+                sortedAccess(address);
+            }
+        }
+        if (geometry.operation != OPERATION_GATHER) {
+            for (uint64_t address : sorted) {
+                sortedAccess(address);
+            }
+        }
+        batch.clear();
+    };
+
+    TraceDecoder decoder(trace);
+    uint64_t index;
+    uint64_t address;
+    uint64_t currentBatch = 0;
+    while (decoder.next(index, address)) {
+        if (index / geometry.updateSplit != currentBatch) {
+            replayBatch();
+            currentBatch = index / geometry.updateSplit;
+        }
+        batch.push_back(address);
+        results->updates++;
+    }
+    replayBatch();
+    return results;
+}
+
+/*
+ @copydoc bm_address_trace::printAnalysis()
+*/
+void
+printAnalysis(MappedTrace const &trace, DRAMGeometry const &geometry,
+              AnalysisResults const &results) {
+    AddressTraceHeader const &header = *trace.header;
+    // Every collision leaves an item with a wrong value in the data chunk
+    uint64_t items = header.dataSize;
+    if (header.replication != ADDRESS_TRACE_ALL_REPLICATIONS) {
+        items /= header.replications;
+    }
+    std::cout << "Trace:" << std::endl
+              << "Data size:           " << header.dataSize << " items"
+              << std::endl
+              << "Replication:         ";
+    if (header.replication == ADDRESS_TRACE_ALL_REPLICATIONS) {
+        std::cout << "all";
+    } else {
+        std::cout << header.replication << " of " << header.replications;
+    }
+    std::cout << std::endl
+              << "Updates:             " << header.accesses << std::endl
+              << "File size:           " << trace.fileSize << " Byte ("
+              << static_cast<double>(header.payloadSize)
+                    / std::max<uint64_t>(header.accesses, 1)
+              << " Byte per update)" << std::endl
+              << "Geometry:            " << geometry.banks << " banks, "
+              << geometry.rowSize << " Byte rows, " << geometry.burstSize
+              << " Byte bursts, " << geometry.itemSize << " Byte items"
+              << std::endl
+              << "Update split:        " << geometry.updateSplit << std::endl
+              << "Operation:           " << operationName(geometry.operation)
+              << std::endl << HLINE;
+
+    // single and single_sorted execute the same updates in a different
+    // order. Collisions are merged by single_sorted, so no errors remain.
+    std::cout << std::setw(ENTRY_SPACE) << "kernel"
+              << std::setw(ENTRY_SPACE) << "accesses"
+              << std::setw(ENTRY_SPACE) << "row hits"
+              << std::setw(ENTRY_SPACE) << "hit rate"
+              << std::setw(ENTRY_SPACE) << "est. error" << std::endl;
+    std::cout << std::setw(ENTRY_SPACE) << "single"
+              << std::setw(ENTRY_SPACE) << results.accesses
+              << std::setw(ENTRY_SPACE) << results.rowHits
+              << std::setw(ENTRY_SPACE)
+              << static_cast<double>(results.rowHits)
+                    / std::max<size_t>(results.accesses, 1)
+              << std::setw(ENTRY_SPACE) << (100.0 * results.collisions
+                                            / items) << std::endl;
+    std::cout << std::setw(ENTRY_SPACE) << "single_sorted"
+              << std::setw(ENTRY_SPACE) << results.sortedAccesses
+              << std::setw(ENTRY_SPACE) << results.sortedRowHits
+              << std::setw(ENTRY_SPACE)
+              << static_cast<double>(results.sortedRowHits)
+                    / std::max<size_t>(results.sortedAccesses, 1)
+              << std::setw(ENTRY_SPACE) << 0.0 << std::endl;
+    std::cout << std::setw(ENTRY_SPACE) << "batches"
+              << std::setw(ENTRY_SPACE) << "collisions"
+              << std::setw(ENTRY_SPACE) << "coll. batch"
+              << std::setw(ENTRY_SPACE) << "shared burst" << std::endl;
+    std::cout << std::setw(ENTRY_SPACE) << results.batches
+              << std::setw(ENTRY_SPACE) << results.collisions
+              << std::setw(ENTRY_SPACE) << results.batchesWithCollisions
+              << std::setw(ENTRY_SPACE) << results.sharedBursts << std::endl
+              << HLINE;
+
+    size_t maxAccesses = *std::max_element(results.bankAccesses.begin(),
+                                           results.bankAccesses.end());
+    double meanAccesses = static_cast<double>(results.accesses)
+                            / geometry.banks;
+    std::cout << std::setw(ENTRY_SPACE) << "bank"
+              << std::setw(ENTRY_SPACE) << "accesses"
+              << std::setw(ENTRY_SPACE) << "share"
+              << std::setw(ENTRY_SPACE) << "hit rate" << std::endl;
+    for (size_t b = 0; b < geometry.banks; b++) {
+        std::cout << std::setw(ENTRY_SPACE) << b
+                  << std::setw(ENTRY_SPACE) << results.bankAccesses[b]
+                  << std::setw(ENTRY_SPACE)
+                  << static_cast<double>(results.bankAccesses[b])
+                        / std::max<size_t>(results.accesses, 1)
+                  << std::setw(ENTRY_SPACE)
+                  << static_cast<double>(results.bankRowHits[b])
+                        / std::max<size_t>(results.bankAccesses[b], 1)
+                  << std::endl;
+    }
+    std::cout << "Bank imbalance (max/mean): "
+              << (meanAccesses > 0 ? maxAccesses / meanAccesses : 0)
+              << std::endl;
+}
+
+}  // namespace bm_address_trace
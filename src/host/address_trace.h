@@ -0,0 +1,251 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_ADDRESS_TRACE_H_
+#define SRC_HOST_ADDRESS_TRACE_H_
+
+/* C++ standard library headers */
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/**
+Identifies a file as address trace
+*/
+#define ADDRESS_TRACE_MAGIC "RAADDRTR"
+
+/**
+Version of the format of the address trace files
+*/
+#define ADDRESS_TRACE_VERSION 1
+
+/**
+Value of the replication in the header of traces that contain the
+unfiltered address stream of the whole data array
+*/
+#define ADDRESS_TRACE_ALL_REPLICATIONS -1
+
+/**
+Contains the export of the address stream of the kernels to a compact trace
+file and an analyzer that replays the trace against the geometry of a DRAM.
+
+A trace file starts with an AddressTraceHeader followed by one record per
+access. The address of a record is stored as LEB128 varint of the zigzag
+encoded difference to the previous address. Traces of a single replication
+additionally store the difference of the update index to the previous
+record in front of the address, because the accesses of other replications
+are skipped.
+*/
+namespace bm_address_trace {
+
+/**
+Header of an address trace file
+*/
+struct AddressTraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t hasIndices;
+    uint64_t dataSize;
+    uint64_t replications;
+    int64_t replication;
+    uint64_t updateSplit;
+    uint64_t accesses;
+    uint64_t payloadSize;
+};
+
+/**
+A trace file mapped into memory
+*/
+struct MappedTrace {
+    AddressTraceHeader const* header;
+    uint8_t const* payload;
+    size_t fileSize;
+};
+
+/**
+Decodes the records of a mapped trace in order
+*/
+class TraceDecoder {
+ public:
+    explicit TraceDecoder(MappedTrace const &trace)
+        : position(trace.payload), end(trace.payload
+                                       + trace.header->payloadSize),
+          hasIndices(trace.header->hasIndices != 0), index(0), address(0),
+          first(true) {}
+
+    /**
+    Decodes the next record
+
+    @param updateIndex Index of the update in the update sequence of the
+            kernel
+    @param itemAddress Address of the item in the data chunk of the
+            replication
+
+    @return false if all records were decoded
+    */
+    inline bool
+    next(uint64_t &updateIndex, uint64_t &itemAddress) {
+        if (position >= end) {
+            return false;
+        }
+        if (hasIndices) {
+            index += readVarint();
+        } else if (!first) {
+            index++;
+        }
+        uint64_t zigzag = readVarint();
+        address += (zigzag >> 1) ^ (0 - (zigzag & 1));
+        first = false;
+        updateIndex = index;
+        itemAddress = address;
+        return true;
+    }
+
+ private:
+    uint8_t const* position;
+    uint8_t const* end;
+    bool hasIndices;
+    uint64_t index;
+    uint64_t address;
+    bool first;
+
+    inline uint64_t
+    readVarint() {
+        uint64_t value = 0;
+        int shift = 0;
+        while (*position & 0x80) {
+            value |= static_cast<uint64_t>(*position & 0x7F) << shift;
+            shift += 7;
+            position++;
+        }
+        value |= static_cast<uint64_t>(*position) << shift;
+        position++;
+        return value;
+    }
+};
+
+/**
+Geometry of the DRAM the trace is replayed against. An item address is
+mapped to a byte address in the data chunk, which is split into the column
+within a row, the bank and the row from the lowest to the highest bits.
+*/
+struct DRAMGeometry {
+    size_t banks;
+    size_t rowSize;
+    size_t burstSize;
+    size_t itemSize;
+    size_t updateSplit;
+    int operation;
+};
+
+/**
+Results of the replay of a trace. The accesses are the loads and stores
+of the updates. The sorted accesses are replayed in the order of the
+single_sorted kernel, which sorts every batch by address and merges the
+updates to the same address.
+*/
+struct AnalysisResults {
+    size_t updates;
+    size_t accesses;
+    size_t rowHits;
+    std::vector<size_t> bankAccesses;
+    std::vector<size_t> bankRowHits;
+    size_t batches;
+    size_t batchesWithCollisions;
+    size_t collisions;
+    size_t sharedBursts;
+    size_t sortedAccesses;
+    size_t sortedRowHits;
+};
+
+/**
+Writes the address stream of a kernel execution to a trace file. The file is
+written through a memory mapping.
+
+@param fileName Name of the trace file
+@param dataSize Number of items in the whole data array. Has to be a power
+        of two.
+@param blockTable The block table of the address distribution as returned
+        by bm_distribution::createBlockTable(). The stream is ran & (m - 1)
+        for the uniform distribution.
+@param replications Number of kernel replications the data array is split
+        into
+@param replication Only the accesses to the data chunk of this replication
+        are written with the addresses within the chunk.
+        ADDRESS_TRACE_ALL_REPLICATIONS writes the whole stream.
+@param updateSplit Number of updates in a batch of the kernels. It is
+        stored in the header as default for the analysis.
+
+@return The header of the written trace
+
+Throws std::runtime_error if the trace file can not be written.
+*/
+AddressTraceHeader
+writeTrace(std::string const &fileName, size_t dataSize,
+           std::vector<cl_uint> const &blockTable, size_t replications,
+           int64_t replication, size_t updateSplit);
+
+/**
+Maps a trace file into memory. Throws std::runtime_error if the file can
+not be read or is no valid trace.
+
+@param fileName Name of the trace file
+
+@return The mapped trace. The mapping is removed with the last reference.
+*/
+std::shared_ptr<MappedTrace>
+mapTrace(std::string const &fileName);
+
+/**
+Replays a trace against the given DRAM geometry. Every batch of
+updateSplit updates first loads all its items and then stores them like
+the kernels, so loads and stores are replayed in two passes. GATHER only
+loads and SCATTER only stores the items. Every bank keeps its last row open.
+Every batch is replayed once in the order of the update sequence like the
+single kernel and once sorted by address like the single_sorted kernel.
+
+@param trace The mapped trace
+@param geometry The geometry of the DRAM and the kernel parameters
+
+@return The row-buffer hits, the load of every bank and the collisions
+        within the batches
+*/
+std::shared_ptr<AnalysisResults>
+analyzeTrace(MappedTrace const &trace, DRAMGeometry const &geometry);
+
+/**
+Prints the results of the analysis of a trace
+
+@param trace The analyzed trace
+@param geometry The used DRAM geometry
+@param results The results of the analysis
+*/
+void
+printAnalysis(MappedTrace const &trace, DRAMGeometry const &geometry,
+              AnalysisResults const &results);
+
+}  // namespace bm_address_trace
+
+#endif  // SRC_HOST_ADDRESS_TRACE_H_
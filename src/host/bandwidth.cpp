@@ -0,0 +1,107 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/bandwidth.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/fpga_setup.h"
+#include "src/host/random_access_definitions.h"
+#include "src/host/trace.h"
+
+namespace bm_execution {
+
+/*
+Executes the streaming kernels of the given replications concurrently
+
+@return the execution time in seconds
+*/
+static double
+executeStreamKernels(std::vector<cl::CommandQueue> const &queues,
+                     std::vector<cl::Kernel> const &kernels,
+                     std::vector<int> const &replications) {
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int r : replications) {
+        queues[r].enqueueTask(kernels[r]);
+    }
+    for (int r : replications) {
+        queues[r].finish();
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> timespan =
+        std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
+    return timespan.count();
+}
+
+/*
+ @copydoc bm_execution::measureBandwidth()
+*/
+std::shared_ptr<BandwidthResults>
+measureBandwidth(std::shared_ptr<ExecutionConfiguration> config,
+                 std::vector<cl::CommandQueue> const &queues,
+                 std::vector<cl::Buffer> const &buffers) {
+    TRACE_SCOPE("bandwidth baseline");
+    int err;
+    std::vector<cl::Kernel> kernels;
+    std::vector<int> allReplications;
+    for (int r=0; r < config->replications; r++) {
+        kernels.push_back(cl::Kernel(config->program,
+                    (BANDWIDTH_KERNEL_NAME + std::to_string(r)).c_str(),
+                    &err));
+        ASSERT_CL(err);
+        err = kernels[r].setArg(0, buffers[r]);
+        ASSERT_CL(err);
+        err = kernels[r].setArg(1,
+                DATA_TYPE_UNSIGNED(config->dataSize / config->replications));
+        ASSERT_CL(err);
+        err = kernels[r].setArg(2, DATA_TYPE_UNSIGNED(POLY));
+        ASSERT_CL(err);
+        allReplications.push_back(r);
+    }
+
+    std::shared_ptr<BandwidthResults> results(new BandwidthResults{
+                std::vector<double>(config->replications,
+                                    std::numeric_limits<double>::max()),
+                std::numeric_limits<double>::max()});
+    for (int i = 0; i < BANDWIDTH_REPETITIONS; i++) {
+        for (int r=0; r < config->replications; r++) {
+            results->bankTimes[r] = std::min(results->bankTimes[r],
+                    executeStreamKernels(queues, kernels, {r}));
+        }
+        results->concurrentTime = std::min(results->concurrentTime,
+                    executeStreamKernels(queues, kernels, allReplications));
+    }
+    return results;
+}
+
+}  // namespace bm_execution
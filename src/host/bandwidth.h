@@ -0,0 +1,64 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_BANDWIDTH_H_
+#define SRC_HOST_BANDWIDTH_H_
+
+/* C++ standard library headers */
+#include <memory>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/execution.h"
+
+/**
+Number of executions of the streaming kernels. The best time is used.
+*/
+#ifndef BANDWIDTH_REPETITIONS
+#define BANDWIDTH_REPETITIONS 3
+#endif
+
+namespace bm_execution {
+
+/**
+Measures the sequential memory bandwidth of every replication with the
+streaming kernels. They have to be synthesized with BANDWIDTH_KERNEL defined.
+First every replication is executed alone to get the bandwidth of a single
+memory bank, then all replications are executed concurrently.
+The content of the data buffers is modified by the measurement.
+
+@param config The configuration of the benchmark run
+@param queues The command queues of all replications
+@param buffers The data buffers of all replications
+
+@return The measured kernel times
+*/
+std::shared_ptr<BandwidthResults>
+measureBandwidth(std::shared_ptr<ExecutionConfiguration> config,
+                 std::vector<cl::CommandQueue> const &queues,
+                 std::vector<cl::Buffer> const &buffers);
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_BANDWIDTH_H_
@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/benchmark_runner.h"
+
+/* C++ standard library headers */
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+namespace bm_execution {
+
+BenchmarkRunner::BenchmarkRunner(ExecutionConfiguration const &config)
+        : config(config) {
+    if (!isKernelType(config.kernelType)) {
+        throw std::runtime_error("Unknown kernel type " + config.kernelType);
+    }
+}
+
+/*
+ @copydoc bm_execution::BenchmarkRunner::setProgressCallback()
+*/
+void
+BenchmarkRunner::setProgressCallback(ProgressCallback callback) {
+    config.progress = callback;
+}
+
+/*
+ @copydoc bm_execution::BenchmarkRunner::submit()
+*/
+std::future<std::shared_ptr<ExecutionResults>>
+BenchmarkRunner::submit() {
+    // Every submission works on its own copy of the configuration
+    std::shared_ptr<ExecutionConfiguration> submitted(
+                                        new ExecutionConfiguration(config));
+    return std::async(std::launch::async, calculate, submitted);
+}
+
+/*
+ @copydoc bm_execution::BenchmarkRunner::run()
+*/
+std::shared_ptr<ExecutionResults>
+BenchmarkRunner::run() {
+    std::shared_ptr<ExecutionConfiguration> submitted(
+                                        new ExecutionConfiguration(config));
+    return calculate(submitted);
+}
+
+}  // namespace bm_execution
@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_BENCHMARK_RUNNER_H_
+#define SRC_HOST_BENCHMARK_RUNNER_H_
+
+/* C++ standard library headers */
+#include <future>
+#include <memory>
+
+/* Project's headers */
+#include "src/host/execution.h"
+
+namespace bm_execution {
+
+/**
+Runs the benchmark for a given configuration without the command line
+interface, so it can be embedded into other applications.
+The kernel type is taken from the configuration and selected at runtime.
+All settings of a run are taken from the configuration, so runners with
+different devices and settings can be executed concurrently. Errors of a
+run, including the error codes of the OpenCL library, are thrown as
+std::runtime_error.
+*/
+class BenchmarkRunner {
+ public:
+    /**
+    Creates a runner for the given configuration. The context, device and
+    program have to be set up already, e.g. with fpga_setup::fpgaSetup().
+    Throws std::runtime_error if the kernel type is unknown.
+
+    @param config The configuration of the benchmark run. It is copied, so
+            later changes do not affect the runner.
+    */
+    explicit BenchmarkRunner(ExecutionConfiguration const &config);
+
+    /**
+    Sets the callback that is called when the benchmark proceeds to the next
+    phase or step. It is called from the thread that executes the benchmark.
+
+    @param callback The progress callback
+    */
+    void
+    setProgressCallback(ProgressCallback callback);
+
+    /**
+    Executes the benchmark in a new thread
+
+    @return A future that contains the results when the benchmark is finished
+            or the error of the run, which is rethrown by its get()
+    */
+    std::future<std::shared_ptr<ExecutionResults>>
+    submit();
+
+    /**
+    Executes the benchmark in the calling thread. Errors of the run are
+    thrown to the caller.
+
+    @return The results of the benchmark
+    */
+    std::shared_ptr<ExecutionResults>
+    run();
+
+ private:
+    ExecutionConfiguration config;
+};
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_BENCHMARK_RUNNER_H_
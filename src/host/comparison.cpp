@@ -0,0 +1,181 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/comparison.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/fpga_setup.h"
+#include "src/host/random_access_definitions.h"
+
+namespace bm_comparison {
+
+/*
+Checks if the kernel type uses the interface of the single kernel. The
+other types take the pre-calculated random numbers as second argument.
+*/
+static bool
+hasSingleInterface(std::string const &kernelType) {
+    return kernelType != "single_rnd" && kernelType != "ndrange";
+}
+
+/*
+Finds the longest kernel type contained in the name of the file, so e.g.
+single_rnd is not detected as single. Returns an empty string if the name
+contains no kernel type.
+*/
+static std::string
+typeFromFileName(std::string const &fileName) {
+    std::string const name = fileName.substr(fileName.find_last_of('/') + 1);
+    std::string found;
+    for (std::string type : {"single", "single_fwd", "single_sorted",
+                             "single_cached", "single_rnd", "ndrange"}) {
+        if (name.find("_" + type) != std::string::npos
+                && type.size() > found.size()) {
+            found = type;
+        }
+    }
+    return found;
+}
+
+/*
+ @copydoc bm_comparison::detectKernelFile()
+*/
+KernelFileInfo
+detectKernelFile(cl::Program const &program, std::string const &fileName,
+                 std::string const &defaultType, int operation) {
+    std::vector<cl::Kernel> kernels;
+    int err = program.createKernels(&kernels);
+    ASSERT_CL(err);
+
+    // Count the replications and get the number of arguments of the first
+    // random access kernel
+    std::string const prefix = RANDOM_ACCESS_KERNEL;
+    uint replications = 0;
+    cl_uint numArgs = 0;
+    for (cl::Kernel const &kernel : kernels) {
+        std::string name = kernel.getInfo<CL_KERNEL_FUNCTION_NAME>();
+        // Some runtimes include the terminating null character
+        name = name.c_str();
+        if (name.compare(0, prefix.size(), prefix) != 0
+                || name.size() == prefix.size()
+                || name.find_first_not_of("0123456789", prefix.size())
+                    != std::string::npos) {
+            continue;
+        }
+        replications++;
+        if (name == prefix + "0") {
+            numArgs = kernel.getInfo<CL_KERNEL_NUM_ARGS>();
+        }
+    }
+    if (replications == 0) {
+        throw std::runtime_error("The kernel file " + fileName
+                                 + " does not contain the kernel " + prefix
+                                 + "0");
+    }
+
+    // The GATHER kernels have an additional argument for the checksum
+    cl_uint const gatherArgs = operation == OPERATION_GATHER ? 1 : 0;
+#ifdef ADDRESS_DISTRIBUTION
+    cl_uint const singleArgs = 4 + gatherArgs;
+#else
+    cl_uint const singleArgs = 3 + gatherArgs;
+#endif
+    cl_uint const randomArgs = 4 + gatherArgs;
+
+    std::string kernelType = typeFromFileName(fileName);
+    if (kernelType.empty()) {
+        if (numArgs == singleArgs && numArgs == randomArgs) {
+            kernelType = defaultType;
+        } else if (numArgs == singleArgs) {
+            kernelType = hasSingleInterface(defaultType) ? defaultType
+                                                         : "single";
+        } else {
+            kernelType = hasSingleInterface(defaultType) ? "single_rnd"
+                                                         : defaultType;
+        }
+    }
+    cl_uint const expectedArgs = hasSingleInterface(kernelType) ? singleArgs
+                                                                : randomArgs;
+    if (numArgs != expectedArgs) {
+        throw std::runtime_error("The kernels in " + fileName + " have "
+                                 + std::to_string(numArgs)
+                                 + " arguments but "
+                                 + std::to_string(expectedArgs)
+                                 + " are expected for the kernel type "
+                                 + kernelType + " and the operation "
+                                 + operationName(operation));
+    }
+    return KernelFileInfo {kernelType, replications};
+}
+
+/*
+ @copydoc bm_comparison::printComparison()
+*/
+void
+printComparison(std::vector<ComparisonEntry> const &entries,
+                size_t dataSize) {
+    double const updates = 4.0 * dataSize;
+    double baseline = 0;
+    std::cout << HLINE << "Comparison of the kernel files:" << std::endl
+              << std::setw(ENTRY_SPACE) << "file"
+              << std::setw(ENTRY_SPACE) << "type"
+              << std::setw(ENTRY_SPACE) << "replications"
+              << std::setw(ENTRY_SPACE) << "best"
+              << std::setw(ENTRY_SPACE) << "GUOPS"
+              << std::setw(ENTRY_SPACE) << "error"
+              << std::setw(ENTRY_SPACE) << "speedup" << std::endl;
+    for (size_t f = 0; f < entries.size(); f++) {
+        std::vector<double> const &times = entries[f].results->times;
+        double tmin = *std::min_element(times.begin(), times.end());
+        double guops = updates / tmin / 1.0e9;
+        if (f == 0) {
+            baseline = guops;
+        }
+        std::cout << std::setw(ENTRY_SPACE) << f
+                  << std::setw(ENTRY_SPACE) << entries[f].info.kernelType
+                  << std::setw(ENTRY_SPACE) << entries[f].info.replications
+                  << std::setw(ENTRY_SPACE) << tmin
+                  << std::setw(ENTRY_SPACE) << guops
+                  << std::setw(ENTRY_SPACE)
+                  << 100.0 * entries[f].results->errorRate
+                  << std::setw(ENTRY_SPACE) << guops / baseline << std::endl;
+    }
+    for (size_t f = 0; f < entries.size(); f++) {
+        std::cout << "File " << f << ": " << entries[f].fileName << std::endl;
+    }
+}
+
+}  // namespace bm_comparison
@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_COMPARISON_H_
+#define SRC_HOST_COMPARISON_H_
+
+/* C++ standard library headers */
+#include <memory>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/execution.h"
+
+namespace bm_comparison {
+
+/**
+Kernel type and number of replications of a kernel file
+*/
+struct KernelFileInfo {
+    std::string kernelType;
+    uint replications;
+};
+
+/**
+Result of a single kernel file in a comparison of multiple kernel files
+*/
+struct ComparisonEntry {
+    std::string fileName;
+    KernelFileInfo info;
+    std::shared_ptr<bm_execution::ExecutionResults> results;
+};
+
+/**
+Detects the kernel type and the number of replications of a kernel file.
+The replications are counted from the names of the random access kernels
+accessMemory0 to accessMemoryN in the program. The kernels of all types
+have the same names, so the number of their arguments is used to distinguish
+the interface of the single kernels from the one of single_rnd and ndrange.
+The exact type is taken from the file name that is given to the bitstreams
+by the Makefile, e.g. random_access_kernels_single_rnd_4_4.aocx. If the
+file name does not contain a type, the default type is used if it has the
+detected interface.
+Throws std::runtime_error if the kernel file does not contain the random
+access kernels or their interface does not match the host code.
+
+@param program The program created from the kernel file
+@param fileName The path to the kernel file
+@param defaultType The kernel type given on the command line
+@param operation The operation the kernels use to update the data
+
+@return The kernel type and the number of replications
+*/
+KernelFileInfo
+detectKernelFile(cl::Program const &program, std::string const &fileName,
+                 std::string const &defaultType, int operation);
+
+/**
+Prints a table that compares the results of all kernel files. The speedup
+is calculated for the GUOPS relative to the first kernel file.
+
+@param entries The results of all kernel files in the order of execution
+@param dataSize Number of entries in the data array
+*/
+void
+printComparison(std::vector<ComparisonEntry> const &entries,
+                size_t dataSize);
+
+}  // namespace bm_comparison
+
+#endif  // SRC_HOST_COMPARISON_H_
@@ -0,0 +1,129 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/execution.h"
+
+/* C++ standard library headers */
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/hybrid.h"
+#include "src/host/kernel_model.h"
+#include "src/host/multi_tenant.h"
+#include "src/host/out_of_core.h"
+#include "src/host/perf_counters.h"
+#include "src/host/trace.h"
+
+namespace bm_execution {
+
+/*
+Selects the implementation of calculate() for the configuration
+*/
+static std::shared_ptr<ExecutionResults>
+calculateImplementation(std::shared_ptr<ExecutionConfiguration> config) {
+    if (config->useModel) {
+        return calculateModel(config);
+    }
+    if (config->windowSize > 0) {
+        return calculateOutOfCore(config);
+    }
+    if (config->hostFraction > 0 || config->balanceHybrid) {
+        return calculateHybrid(config);
+    }
+    if (config->tenants > 0) {
+        return calculateMultiTenant(config);
+    }
+    // The forwarding, sorting and caching kernels have the same interface
+    // as the single kernel
+    if (config->kernelType == "single" || config->kernelType == "single_fwd"
+            || config->kernelType == "single_sorted"
+            || config->kernelType == "single_cached") {
+        return calculateSingle(config);
+    }
+    if (config->kernelType == "single_rnd") {
+        return calculateSingleRnd(config);
+    }
+    if (config->kernelType == "ndrange") {
+        return calculateNDRange(config);
+    }
+    throw std::runtime_error("Unknown kernel type " + config->kernelType);
+}
+
+/*
+ @copydoc bm_execution::calculate()
+*/
+std::shared_ptr<ExecutionResults>
+calculate(std::shared_ptr<ExecutionConfiguration> config) {
+    // The host phases and the trace switches are kept per thread, so
+    // concurrent runs do not mix their counters and settings
+    bm_perf::ScopedEnable perfCounters(config->perfCounters);
+    bm_trace::ScopedRecording trace(config->trace);
+    bm_perf::resetPhases();
+    std::shared_ptr<ExecutionResults> results =
+                                        calculateImplementation(config);
+    results->phaseCounters = bm_perf::phases();
+    return results;
+}
+
+/*
+ @copydoc bm_execution::isKernelType()
+*/
+bool
+isKernelType(std::string const &kernelType) {
+    return kernelType == "single" || kernelType == "single_fwd"
+            || kernelType == "single_sorted" || kernelType == "single_cached"
+            || kernelType == "single_rnd" || kernelType == "ndrange";
+}
+
+/*
+ @copydoc bm_execution::createErrorMap()
+*/
+std::shared_ptr<ErrorMap>
+createErrorMap(ExecutionConfiguration const &config) {
+    if (config.heatmapRegions == 0) {
+        return nullptr;
+    }
+    return std::shared_ptr<ErrorMap>(new ErrorMap {
+                std::vector<size_t>(config.replications, 0),
+                std::vector<size_t>(config.heatmapRegions, 0),
+                bm_distribution::chunkFractions(config.blockTable,
+                                                config.dataSize,
+                                                config.replications)});
+}
+
+/*
+ @copydoc bm_execution::reportProgress()
+*/
+void
+reportProgress(ExecutionConfiguration const &config,
+               std::string const &phase, size_t done, size_t total) {
+    if (config.progress) {
+        config.progress(phase, done, total);
+    }
+}
+
+}  // namespace bm_execution
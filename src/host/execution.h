@@ -23,48 +23,348 @@ SOFTWARE.
 #define SRC_HOST_EXECUTION_H_
 
 /* C++ standard library headers */
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 /* External library headers */
 #include "CL/cl.hpp"
 
+/* Project's headers */
+#include "src/host/perf_counters.h"
+
 
 namespace bm_execution {
 
+/**
+Callback used to report the progress of the phases of a benchmark run.
+
+@param phase The name of the current phase, e.g. "execute"
+@param done Number of finished steps of the phase
+@param total Total number of steps of the phase. 0 if it is not known in
+        advance.
+*/
+typedef std::function<void(std::string const &phase, size_t done,
+                           size_t total)> ProgressCallback;
+
+/**
+Data buffers that are shared by consecutive benchmark runs in the same
+context, e.g. when multiple kernel files are compared. The buffers are
+replaced if a run needs a different size or placement.
+
+@see bm_execution::createDataBuffers()
+*/
+struct SharedBuffers {
+    std::vector<int> memoryBanks;
+    bool useSubBuffers;
+    size_t chunkSize;
+    std::vector<cl::Buffer> buffers;
+};
+
+/**
+This struct contains all the settings that are needed by the calculate call
+to execute the benchmark on the device. It contains all the state of a run,
+so runs with different configurations do not affect each other. Settings
+that are not used can be left value-initialized.
+
+@see bm_execution::calculate()
+*/
+struct ExecutionConfiguration {
+    cl::Context context;
+    cl::Device device;
+    cl::Program program;
+    uint repetitions;
+    uint warmupRepetitions;
+    uint maxRepetitions;
+    double targetRSE;
+    uint replications;
+    size_t dataSize;
+    std::vector<int> memoryBanks;
+    bool useSubBuffers;
+    double soakDuration;
+    double soakConfidence;
+    double soakInterval;
+    bool measureBandwidth;
+    bool measureLatency;
+    int operation;
+    std::vector<cl_uint> blockTable;
+    size_t windowSize;
+    std::string tableFileName;
+    std::string kernelType;
+    bool useModel;
+    double hostFraction;
+    bool balanceHybrid;
+    uint hostThreads;
+    uint tenants;
+    bool serialLaunch;
+    uint heatmapRegions;
+    bool trace;
+    bool perfCounters;
+    std::shared_ptr<SharedBuffers> sharedBuffers;
+    ProgressCallback progress;
+};
+
+/**
+Contains the kernel times of the sequential bandwidth baseline.
+
+@see bm_execution::measureBandwidth()
+*/
+struct BandwidthResults {
+    // Best time of every replication executed alone
+    std::vector<double> bankTimes;
+    // Best time of all replications executed concurrently
+    double concurrentTime;
+};
+
+/**
+Contains the latency of dependent reads measured by pointer chasing.
+
+@see bm_execution::measureLatency()
+*/
+struct LatencyResults {
+    // Number of items in the pointer chain for every measurement
+    std::vector<size_t> sizes;
+    // Average time in ns per dependent read for every size and replication
+    std::vector<std::vector<double>> latencies;
+};
+
+/**
+Contains the split of the data array and the times of both sides of a
+co-execution on the device and the host.
+
+@see bm_execution::calculateHybrid()
+*/
+struct HybridResults {
+    // Number of entries updated by the device and by the host
+    size_t deviceEntries;
+    size_t hostEntries;
+    // Number of updates applied by the device and by the host per execution
+    size_t deviceUpdates;
+    size_t hostUpdates;
+    // Number of threads of the host engine
+    uint hostThreads;
+    // Times of the device and of the host for every measured execution
+    std::vector<double> deviceTimes;
+    std::vector<double> hostTimes;
+};
+
+/**
+Contains the times and the error rates of the tenants of the multi-tenant
+mode.
+
+@see bm_execution::calculateMultiTenant()
+*/
+struct TenantResults {
+    // Number of entries in the table of every tenant
+    size_t tableSize;
+    // Times of every tenant for every measured execution
+    std::vector<std::vector<double>> times;
+    // Error rate in the table of every tenant
+    std::vector<double> errorRates;
+};
+
+/**
+Contains the mean times of the kernel launches of all replications in
+seconds since the release of a launch.
+
+@see bm_execution::LaunchEngine
+*/
+struct LaunchResults {
+    // The kernels were launched one after another from a single thread
+    bool serial;
+    // Mean time until the kernel of every replication was submitted
+    std::vector<double> startOffsets;
+    // Mean time until the kernel of every replication finished
+    std::vector<double> finishTimes;
+};
+
+/**
+Contains the number of wrong entries found by the verification in the chunk
+of every replication and in every equally sized address region of the data
+array, together with the share of the updates of every chunk.
+
+@see bm_verification::verifyData()
+*/
+struct ErrorMap {
+    // Number of wrong entries in the chunk of every replication
+    std::vector<size_t> chunkErrors;
+    // Number of wrong entries in every address region
+    std::vector<size_t> regionErrors;
+    // Fraction of all updates that go to the chunk of every replication
+    std::vector<double> chunkUpdates;
+};
+
 /**
 This struct is returned by the calculate call and contains the measured
 runtimes and the error rate in the data set after the updates.
+If the bandwidth baseline or the latency was measured, the device and the
+host were used together or multiple tenants were executed, it also contains
+their results. The times of the kernel launches are contained if the
+implementation uses the launch engine. The wrong entries of every chunk and
+address region are contained if the error heatmap is enabled. If the hardware
+counters are enabled, it contains the counters of every host phase of the
+run.
 
 @see bm_execution::calculate()
 */
 struct ExecutionResults {
     std::vector<double> times;
     double errorRate;
+    std::shared_ptr<BandwidthResults> bandwidth;
+    std::shared_ptr<LatencyResults> latency;
+    std::shared_ptr<HybridResults> hybrid;
+    std::shared_ptr<TenantResults> tenants;
+    std::shared_ptr<LaunchResults> launch;
+    std::shared_ptr<ErrorMap> errorMap;
+    std::vector<bm_perf::PhaseCounters> phaseCounters;
 };
 
 /**
 The actual execution of the benchmark.
-This method can be implemented in multiple *.cpp files. This header enables
-simple exchange of the different calculation methods.
-
-@param context OpenCL context used to create needed Buffers and queues
-@param device The OpenCL device that is used to execute the benchmarks
-@param program The OpenCL program containing the kernels
-@param repetitions Number of times the kernels are executed
-@param replications Number of times a kernel is replicated - may be used in
-                    different ways depending on the implementation of this
+The implementation for the kernel type given in the configuration is
+selected at runtime. Every kernel type is implemented in its own *.cpp file.
+If a window size is given, calculateOutOfCore() is used instead. If a host
+fraction is given or the auto-balance is enabled, calculateHybrid() is used.
+If tenants are given, calculateMultiTenant() is used.
+
+@param config The configuration of the benchmark run. It contains:
+        - context: OpenCL context used to create needed Buffers and queues
+        - device: The OpenCL device that is used to execute the benchmarks
+        - program: The OpenCL program containing the kernels
+        - repetitions: Number of times the kernels are executed
+        - warmupRepetitions: Number of additional executions before the
+                measurement that are excluded from the results
+        - maxRepetitions: Maximum number of repetitions if targetRSE is used
+        - targetRSE: If > 0, the kernels are executed until the relative
+                standard error of the kernel time drops below this value or
+                maxRepetitions is reached. repetitions is used as minimum.
+        - replications: Number of times a kernel is replicated - may be used
+                    in different ways depending on the implementation of this
                     method
-@param dataSize The size of the data array that may be used for benchmark
+        - dataSize: The size of the data array that may be used for benchmark
                 execution in number of items
-@param useMemInterleaving Prepare buffers using memory interleaving
+        - memoryBanks: The memory bank of the data buffer of every
+                replication. INTERLEAVED_BANK for interleaved buffers.
+        - useSubBuffers: Create a single interleaved data buffer and split it
+                into sub-buffers for the replications
+        - soakDuration: If > 0, the kernels are executed repeatedly for the
+                given number of seconds instead of the given repetitions
+        - soakConfidence: Stop the soak run early if the relative half width
+                of the 95% confidence interval of the GUOPS drops below this
+                value. Disabled if <= 0.
+        - soakInterval: Minimum time in seconds covered by a single
+                throughput sample printed during the soak run
+        - measureBandwidth: Measure the sequential bandwidth of every memory
+                bank before the random accesses
+        - measureLatency: Measure the latency of dependent reads for every
+                memory bank before the random accesses
+        - operation: The operation the kernels use to update the data, e.g.
+                OPERATION_XOR. It is needed for the verification.
+        - blockTable: The block table of the address distribution as
+                returned by bm_distribution::createBlockTable(). Empty for
+                the uniform distribution.
+        - windowSize: If > 0, the out-of-core mode is used. Number of items
+                of the data array that are placed on the device in a pass
+        - tableFileName: Only used by calculateOutOfCore(). If not empty, the
+                data array is mapped from this file instead of host memory
+        - kernelType: The type of the kernels in the program. One of single,
+                single_fwd, single_sorted, single_cached, single_rnd or
+                ndrange.
+        - useModel: Execute the functional model of the kernels on the host
+                instead of the program on the device
+        - hostFraction: If > 0, fraction of the data array that is updated
+                by the host together with the device
+        - balanceHybrid: Adjust the fraction of the host from the measured
+                rates of the device and the host before the measurement
+        - hostThreads: Number of threads of the host engine used together
+                with the device
+        - tenants: If > 0, number of tenants that update independent tables
+                concurrently in the multi-tenant mode
+        - serialLaunch: Launch the kernels of all replications one after
+                another from a single thread instead of one thread per
+                replication
+        - heatmapRegions: If > 0, the wrong entries are also counted in the
+                chunk of every replication and in the given number of
+                address regions for the error heatmap
+        - trace: Add the phases of the run to the trace enabled with
+                bm_trace::enable()
+        - perfCounters: Measure the hardware counters of the host phases
+                of the run
+        - sharedBuffers: Optional data buffers that are reused from the
+                previous run with the same size and placement. They are
+                not used in the out-of-core mode, which needs a separate
+                set of window buffers for every buffer set.
+        - progress: Optional callback that is called when the benchmark
+                proceeds to the next phase or step
+
+@return The time measurements without warm-up and the error rate counted from
+        the executions
+
+Throws std::runtime_error if the run can not be executed with the given
+configuration, an OpenCL call returns an error or the kernels fail, so the
+error can be handled by the caller.
+*/
+std::shared_ptr<ExecutionResults>
+calculate(std::shared_ptr<ExecutionConfiguration> config);
+
+/**
+Implementation of calculate() for the single kernel
+
+@copydoc bm_execution::calculate()
+*/
+std::shared_ptr<ExecutionResults>
+calculateSingle(std::shared_ptr<ExecutionConfiguration> config);
+
+/**
+Implementation of calculate() for the single_rnd kernel
 
-@return The time measurements and the error rate counted from the executions
+@copydoc bm_execution::calculate()
 */
 std::shared_ptr<ExecutionResults>
-calculate(cl::Context context, cl::Device device, cl::Program program,
-               uint repetitions, uint replications, size_t dataSize,
-               bool useMemInterleaving);
+calculateSingleRnd(std::shared_ptr<ExecutionConfiguration> config);
+
+/**
+Implementation of calculate() for the ndrange kernel
+
+@copydoc bm_execution::calculate()
+*/
+std::shared_ptr<ExecutionResults>
+calculateNDRange(std::shared_ptr<ExecutionConfiguration> config);
+
+/**
+Checks if an implementation for the given kernel type exists
+
+@param kernelType The kernel type, e.g. single
+
+@return true, if the kernel type can be used with calculate()
+*/
+bool
+isKernelType(std::string const &kernelType);
+
+/**
+Creates the error map filled by the verification if the error heatmap is
+enabled
+
+@param config The configuration of the benchmark run
+
+@return An empty error map for the replications and address regions of the
+        configuration or nullptr if heatmapRegions is 0
+*/
+std::shared_ptr<ErrorMap>
+createErrorMap(ExecutionConfiguration const &config);
+
+/**
+Calls the progress callback of the configuration if it is set
+
+@param config The configuration of the benchmark run
+@param phase The name of the current phase
+@param done Number of finished steps of the phase
+@param total Total number of steps of the phase or 0 if it is unknown
+*/
+void
+reportProgress(ExecutionConfiguration const &config,
+               std::string const &phase, size_t done, size_t total);
 
 }  // namespace bm_execution
 
@@ -24,154 +24,56 @@ SOFTWARE.
 #include "src/host/execution.h"
 
 /* C++ standard library headers */
-#include <chrono>
-#include <fstream>
 #include <memory>
 #include <vector>
 
 /* External library headers */
 #include "CL/cl.hpp"
-#if QUARTUS_MAJOR_VERSION > 18
-#include "CL/cl_ext_intelfpga.h"
-#endif
 
 /* Project's headers */
+#include "src/host/address_distribution.h"
 #include "src/host/fpga_setup.h"
-#include "src/host/random_access_functionality.h"
+#include "src/host/kernel_execution.h"
+#include "src/host/random_access_definitions.h"
 
 namespace bm_execution {
 
     /*
     Implementation for the single kernel.
-     @copydoc bm_execution::calculate()
+     @copydoc bm_execution::calculateSingle()
     */
     std::shared_ptr<ExecutionResults>
-    calculate(cl::Context context, cl::Device device, cl::Program program,
-                   uint repetitions, uint replications, size_t dataSize,
-                   bool useMemInterleaving) {
-        // int used to check for OpenCL errors
-        int err;
-
-        std::vector<cl::CommandQueue> compute_queue;
-        std::vector<cl::Buffer> Buffer_data;
-        std::vector<cl::Buffer> Buffer_random;
-        std::vector<cl::Kernel> accesskernel;
-        std::vector<DATA_TYPE_UNSIGNED*> data_sets;
-
-        /* --- Prepare kernels --- */
-
-        for (int r=0; r < replications; r++) {
-            DATA_TYPE_UNSIGNED* data;
-            posix_memalign(reinterpret_cast<void **>(&data), 64,
-                           sizeof(DATA_TYPE)*(dataSize / replications));
-            data_sets.push_back(data);
-
-            compute_queue.push_back(cl::CommandQueue(context, device));
-
-            // Select memory bank to place data replication
-            int channel = 0;
-            if (!useMemInterleaving) {
-                switch ((r % replications) + 1) {
-                    case 1: channel = CL_CHANNEL_1_INTELFPGA; break;
-                    case 2: channel = CL_CHANNEL_2_INTELFPGA; break;
-                    case 3: channel = CL_CHANNEL_3_INTELFPGA; break;
-                    case 4: channel = CL_CHANNEL_4_INTELFPGA; break;
-                    case 5: channel = CL_CHANNEL_5_INTELFPGA; break;
-                    case 6: channel = CL_CHANNEL_6_INTELFPGA; break;
-                    case 7: channel = CL_CHANNEL_7_INTELFPGA; break;
-                }
-            }
-
-            Buffer_data.push_back(cl::Buffer(context, channel |
-                        CL_MEM_READ_WRITE,
-                        sizeof(DATA_TYPE_UNSIGNED)*(dataSize / replications)));
-            accesskernel.push_back(cl::Kernel(program,
-                        (RANDOM_ACCESS_KERNEL + std::to_string(r)).c_str() ,
-                        &err));
+    calculateSingle(std::shared_ptr<ExecutionConfiguration> config) {
+        DATA_TYPE_UNSIGNED const dataSize = config->dataSize;
+        DATA_TYPE_UNSIGNED const chunkSize = dataSize / config->replications;
+        std::vector<cl::Buffer> Buffer_block_table;
+
+        // The kernels generate their random numbers from the data size
+        auto setArguments = [&](cl::Kernel &kernel, cl::CommandQueue &queue,
+                                uint) {
+            int err = kernel.setArg(1, dataSize);
             ASSERT_CL(err);
-
-            // prepare kernels
-            err = accesskernel[r].setArg(0, Buffer_data[r]);
+            err = kernel.setArg(2, chunkSize);
             ASSERT_CL(err);
-            err = accesskernel[r].setArg(1, DATA_TYPE_UNSIGNED(dataSize));
+            cl_uint const checksumArg = 3;
+#ifdef ADDRESS_DISTRIBUTION
+            // The kernels copy the block table of the address distribution
+            // to local memory before the updates
+            std::vector<cl_uint> table =
+                    bm_distribution::deviceBlockTable(config->blockTable);
+            Buffer_block_table.push_back(cl::Buffer(config->context,
+                            CL_MEM_READ_ONLY, sizeof(cl_uint) * table.size()));
+            queue.enqueueWriteBuffer(Buffer_block_table.back(), CL_TRUE, 0,
+                                     sizeof(cl_uint) * table.size(),
+                                     table.data());
+            err = kernel.setArg(config->operation == OPERATION_GATHER
+                                        ? checksumArg + 1 : checksumArg,
+                                Buffer_block_table.back());
             ASSERT_CL(err);
-            err = accesskernel[r].setArg(2,
-                                DATA_TYPE_UNSIGNED(dataSize / replications));
-            ASSERT_CL(err);
-        }
-
-        /* --- Execute actual benchmark kernels --- */
-
-        double t;
-        std::vector<double> executionTimes;
-        for (int i = 0; i < repetitions; i++) {
-            // prepare data and send them to device
-            for (DATA_TYPE_UNSIGNED r =0; r < replications; r++) {
-                for (DATA_TYPE_UNSIGNED j=0;
-                     j < (dataSize / replications); j++) {
-                    data_sets[r][j] = r*(dataSize / replications) + j;
-                }
-            }
-            for (int r=0; r < replications; r++) {
-                compute_queue[r].enqueueWriteBuffer(Buffer_data[r], CL_TRUE, 0,
-                     sizeof(DATA_TYPE)*(dataSize / replications), data_sets[r]);
-            }
-
-            // Execute benchmark kernels
-            auto t1 = std::chrono::high_resolution_clock::now();
-            for (int r=0; r < replications; r++) {
-                compute_queue[r].enqueueTask(accesskernel[r]);
-            }
-            for (int r=0; r < replications; r++) {
-                compute_queue[r].finish();
-            }
-            auto t2 = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> timespan =
-                std::chrono::duration_cast<std::chrono::duration<double>>
-                                                                    (t2 - t1);
-            executionTimes.push_back(timespan.count());
-        }
-
-        /* --- Read back results from Device --- */
-
-        for (int r=0; r < replications; r++) {
-            compute_queue[r].enqueueReadBuffer(Buffer_data[r], CL_TRUE, 0,
-                     sizeof(DATA_TYPE)*(dataSize / replications), data_sets[r]);
-        }
-        DATA_TYPE_UNSIGNED* data;
-        posix_memalign(reinterpret_cast<void **>(&data), 64,
-                                        (sizeof(DATA_TYPE)*dataSize));
-        for (size_t r =0; r < replications; r++) {
-            for (size_t j=0; j < (dataSize / replications); j++) {
-                data[r*(dataSize / replications) + j] = data_sets[r][j];
-            }
-            free(reinterpret_cast<void *>(data_sets[r]));
-        }
-
-        /* --- Check Results --- */
-
-        DATA_TYPE_UNSIGNED temp = 1;
-        for (DATA_TYPE_UNSIGNED i=0; i < 4L*dataSize; i++) {
-            DATA_TYPE v = 0;
-            if (((DATA_TYPE)temp) < 0) {
-                v = POLY;
-            }
-            temp = (temp << 1) ^ v;
-            data[temp & (dataSize - 1)] ^= temp;
-        }
-
-        double errors = 0;
-        for (DATA_TYPE_UNSIGNED i=0; i< dataSize; i++) {
-            if (data[i] != i) {
-                errors++;
-            }
-        }
-        free(reinterpret_cast<void *>(data));
-
-        std::shared_ptr<ExecutionResults> results(
-                        new ExecutionResults{executionTimes,
-                                             errors / dataSize});
-        return results;
+#endif
+            return checksumArg;
+        };
+        return executeKernels(config, setArguments, 0);
     }
 
 }  // namespace bm_execution
@@ -31,10 +31,14 @@ SOFTWARE.
 #include <iostream>
 #include <vector>
 #include <iomanip>
+#include <stdexcept>
 
 /* External libraries */
 #include "CL/cl.hpp"
 
+/* Project's headers */
+#include "src/host/trace.h"
+
 
 /**
 Includes several helper functions to develop and execute benchmarks on Intel
@@ -53,25 +57,30 @@ fpgaSetup(cl::Context context, std::vector<cl::Device> deviceList,
     std::cout << HLINE;
     std::cout << "FPGA Setup:" << usedKernelFile << std::endl;
 
-    // Open file stream if possible
-    std::ifstream aocxStream(usedKernelFile, std::ifstream::binary);
-    if (!aocxStream.is_open()) {
-        std::cerr << "Not possible to open from given file!" << std::endl;
-    }
+    cl::Program::Binaries mybinaries;
+    {
+        TRACE_SCOPE("read kernel file");
+        // Open file stream if possible
+        std::ifstream aocxStream(usedKernelFile, std::ifstream::binary);
+        if (!aocxStream.is_open()) {
+            throw std::runtime_error("Not possible to open the kernel file "
+                                     + usedKernelFile);
+        }
 
-    // Read in file contents and create program from binaries
-    std::string prog(std::istreambuf_iterator<char>(aocxStream),
-                    (std::istreambuf_iterator<char>()));
-    aocxStream.seekg(0, aocxStream.end);
-    unsigned file_size = aocxStream.tellg();
-    aocxStream.seekg(0, aocxStream.beg);
-    char * buf = new char[file_size];
-    aocxStream.read(buf, file_size);
+        // Read in file contents and create program from binaries
+        std::string prog(std::istreambuf_iterator<char>(aocxStream),
+                        (std::istreambuf_iterator<char>()));
+        aocxStream.seekg(0, aocxStream.end);
+        unsigned file_size = aocxStream.tellg();
+        aocxStream.seekg(0, aocxStream.beg);
+        char * buf = new char[file_size];
+        aocxStream.read(buf, file_size);
 
-    cl::Program::Binaries mybinaries;
-    mybinaries.push_back({buf, file_size});
+        mybinaries.push_back({buf, file_size});
+    }
 
     // Create the Program from the AOCX file.
+    TRACE_SCOPE("program device");
     cl::Program program(context, deviceList, mybinaries, NULL, &err);
     ASSERT_CL(err);
     std::cout << "Prepared FPGA successfully for global Execution!" <<
@@ -106,6 +115,7 @@ setupEnvironmentAndClocks() {
 */
 std::vector<cl::Device>
 selectFPGADevice(int defaultPlatform, int defaultDevice) {
+    TRACE_SCOPE("select device");
     // Integer used to store return codes of OpenCL library calls
     int err;
 
@@ -119,10 +129,10 @@ selectFPGADevice(int defaultPlatform, int defaultDevice) {
         if (defaultPlatform < platformList.size()) {
             chosenPlatformId = defaultPlatform;
         } else {
-            std::cerr << "Default platform " << defaultPlatform
-            << " can not be used. Available platforms: "
-            << platformList.size() << std::endl;
-            exit(1);
+            throw std::runtime_error("Default platform "
+                        + std::to_string(defaultPlatform)
+                        + " can not be used. Available platforms: "
+                        + std::to_string(platformList.size()));
         }
     } else if (platformList.size() > 1) {
         std::cout <<
@@ -152,10 +162,10 @@ selectFPGADevice(int defaultPlatform, int defaultDevice) {
         if (defaultDevice < deviceList.size()) {
             chosenDeviceId = defaultDevice;
         } else {
-            std::cerr << "Default platform " << defaultDevice
-            << " can not be used. Available platforms: "
-            << deviceList.size()  << std::endl;
-            exit(1);
+            throw std::runtime_error("Default device "
+                        + std::to_string(defaultDevice)
+                        + " can not be used. Available devices: "
+                        + std::to_string(deviceList.size()));
         }
     } else if (deviceList.size() > 1) {
         std::cout <<
@@ -193,10 +203,9 @@ handleClReturnCode(cl_int const err, std::string const file,
                    int const line) {
     if (err != CL_SUCCESS) {
         std::string err_string = getCLErrorString(err);
-        std::cerr << "ERROR in OpenCL library detected! Aborting."
-                  << std::endl << file << ":" << line << ": " << err_string
-                  << std::endl;
-        exit(err);
+        throw std::runtime_error("ERROR in OpenCL library detected in "
+                                 + file + ":" + std::to_string(line) + ": "
+                                 + err_string);
     }
 }
 
@@ -55,6 +55,9 @@ Sets up the given FPGA with the kernel in the provided file.
 @param program The devices used for the program
 @param usedKernelFile The path to the kernel file
 @return The program that is used to create the benchmark kernels
+
+Throws std::runtime_error if the kernel file can not be read or the device
+can not be programmed with it.
 */
 cl::Program
 fpgaSetup(cl::Context context, std::vector<cl::Device> deviceList,
@@ -80,6 +83,8 @@ choose a device.
                         interactively
 
 @return A list containing a single selected device
+
+Throws std::runtime_error if the given platform or device does not exist.
 */
 std::vector<cl::Device>
 selectFPGADevice(int defaultPlatform, int defaultDevice);
@@ -97,8 +102,8 @@ getCLErrorString(cl_int const err);
 
 /**
 Check the OpenCL return code for errors.
-If an error is detected, it will be printed and the programm execution is
-stopped.
+If an error is detected, it is thrown as std::runtime_error containing the
+file, the line and the name of the error code.
 
 @param err The OpenCL error code
 */
@@ -0,0 +1,214 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/heatmap.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/fpga_setup.h"
+#include "src/host/random_access_definitions.h"
+
+/**
+Characters used for the regions of the heatmap with increasing number of
+wrong entries. Regions without errors are drawn as blank.
+*/
+#define HEATMAP_SCALE " .:-=+*#%@"
+
+/**
+Number of regions that are drawn in a row of the heatmap
+*/
+#define HEATMAP_ROW_LENGTH 64
+
+namespace bm_heatmap {
+
+/*
+Values of the chunk of a replication shown in the heatmap
+*/
+struct ChunkValues {
+    size_t errors;
+    double errorRate;
+    // Fraction of all updates that go to the chunk
+    double updateFraction;
+    // Mean finish time of the kernel of the replication or < 0 if unknown
+    double finishTime;
+    double guops;
+};
+
+/*
+Calculates the values of the chunks of all replications. The updates of a
+chunk are taken from the error map, so the GUOPS of a replication are the
+updates to its chunk per finish time of its kernel.
+*/
+static std::vector<ChunkValues>
+chunkValues(bm_execution::ExecutionResults const &results, size_t dataSize) {
+    bm_execution::ErrorMap const &errorMap = *results.errorMap;
+    size_t const replications = errorMap.chunkErrors.size();
+    std::vector<double> const &fractions = errorMap.chunkUpdates;
+    std::vector<ChunkValues> chunks;
+    for (size_t r = 0; r < replications; r++) {
+        ChunkValues chunk {errorMap.chunkErrors[r],
+                           static_cast<double>(errorMap.chunkErrors[r])
+                                * replications / dataSize,
+                           fractions[r], -1, -1};
+        if (results.launch && r < results.launch->finishTimes.size()
+                && results.launch->finishTimes[r] > 0) {
+            chunk.finishTime = results.launch->finishTimes[r];
+            chunk.guops = 4.0 * dataSize * fractions[r] / chunk.finishTime
+                            / 1.0e9;
+        }
+        chunks.push_back(chunk);
+    }
+    return chunks;
+}
+
+/*
+ @copydoc bm_heatmap::printHeatmap()
+*/
+void
+printHeatmap(std::shared_ptr<bm_execution::ExecutionResults> results,
+             size_t dataSize) {
+    bm_execution::ErrorMap const &errorMap = *results->errorMap;
+    std::vector<ChunkValues> chunks = chunkValues(*results, dataSize);
+    std::cout << HLINE << "Error heatmap of the replications:" << std::endl
+              << std::setw(ENTRY_SPACE) << "bank"
+              << std::setw(ENTRY_SPACE) << "errors"
+              << std::setw(ENTRY_SPACE) << "error"
+              << std::setw(ENTRY_SPACE) << "updates"
+              << std::setw(ENTRY_SPACE) << "finish [s]"
+              << std::setw(ENTRY_SPACE) << "GUOPS" << std::endl;
+    for (size_t r = 0; r < chunks.size(); r++) {
+        std::cout << std::setw(ENTRY_SPACE) << r
+                  << std::setw(ENTRY_SPACE) << chunks[r].errors
+                  << std::setw(ENTRY_SPACE) << 100.0 * chunks[r].errorRate
+                  << std::setw(ENTRY_SPACE)
+                  << 100.0 * chunks[r].updateFraction
+                  << std::setw(ENTRY_SPACE);
+        if (chunks[r].finishTime < 0) {
+            std::cout << "n/a" << std::setw(ENTRY_SPACE) << "n/a";
+        } else {
+            std::cout << chunks[r].finishTime << std::setw(ENTRY_SPACE)
+                      << chunks[r].guops;
+        }
+        std::cout << std::endl;
+    }
+
+    std::vector<size_t> const &regionErrors = errorMap.regionErrors;
+    size_t const regionSize = dataSize / regionErrors.size();
+    size_t const worst = std::max_element(regionErrors.begin(),
+                                          regionErrors.end())
+                            - regionErrors.begin();
+    size_t const maxErrors = regionErrors[worst];
+    std::string const scale = HEATMAP_SCALE;
+    std::cout << "Error heatmap of " << regionErrors.size()
+              << " address regions of " << regionSize << " entries:"
+              << std::endl;
+    for (size_t first = 0; first < regionErrors.size();
+                                        first += HEATMAP_ROW_LENGTH) {
+        std::cout << std::setw(ENTRY_SPACE) << first << " |";
+        size_t const last = std::min(first + HEATMAP_ROW_LENGTH,
+                                     regionErrors.size());
+        for (size_t g = first; g < last; g++) {
+            // Every region with errors gets at least the first level
+            size_t level = 0;
+            if (regionErrors[g] > 0) {
+                level = 1 + (regionErrors[g] - 1) * (scale.size() - 1)
+                                / maxErrors;
+            }
+            std::cout << scale[level];
+        }
+        std::cout << "|" << std::endl;
+    }
+    std::cout << "Scale: \"" << scale << "\" up to "
+              << 100.0 * maxErrors / regionSize << "% errors";
+    if (maxErrors > 0) {
+        std::cout << " in region " << worst << " (entries "
+                  << worst * regionSize << " to "
+                  << (worst + 1) * regionSize - 1 << ")";
+    }
+    std::cout << std::endl;
+}
+
+/*
+Writes a value to the JSON file or null if it is not known
+*/
+static void
+writeValue(std::ostream &file, double value) {
+    if (value < 0) {
+        file << "null";
+    } else {
+        file << value;
+    }
+}
+
+/*
+ @copydoc bm_heatmap::writeHeatmap()
+*/
+void
+writeHeatmap(std::shared_ptr<bm_execution::ExecutionResults> results,
+             size_t dataSize, std::string const &fileName) {
+    std::ofstream file(fileName);
+    if (!file.is_open()) {
+        std::cerr << "Not possible to open heatmap file " << fileName
+                  << std::endl;
+        return;
+    }
+    std::vector<size_t> const &regionErrors = results->errorMap->regionErrors;
+    std::vector<ChunkValues> chunks = chunkValues(*results, dataSize);
+    size_t const regionSize = dataSize / regionErrors.size();
+    file << std::setprecision(9) << "{\"dataSize\":" << dataSize
+         << ",\"errorRate\":" << results->errorRate << "," << std::endl
+         << "\"replications\":[" << std::endl;
+    for (size_t r = 0; r < chunks.size(); r++) {
+        file << "{\"replication\":" << r
+             << ",\"errors\":" << chunks[r].errors
+             << ",\"errorRate\":" << chunks[r].errorRate
+             << ",\"updateFraction\":" << chunks[r].updateFraction
+             << ",\"finishTime\":";
+        writeValue(file, chunks[r].finishTime);
+        file << ",\"GUOPS\":";
+        writeValue(file, chunks[r].guops);
+        file << "}" << (r + 1 < chunks.size() ? "," : "") << std::endl;
+    }
+    file << "]," << std::endl
+         << "\"regionSize\":" << regionSize << "," << std::endl
+         << "\"regions\":[" << std::endl;
+    for (size_t g = 0; g < regionErrors.size(); g++) {
+        file << "{\"first\":" << g * regionSize
+             << ",\"errors\":" << regionErrors[g]
+             << ",\"errorRate\":"
+             << static_cast<double>(regionErrors[g]) / regionSize << "}"
+             << (g + 1 < regionErrors.size() ? "," : "") << std::endl;
+    }
+    file << "]}" << std::endl;
+    std::cout << "Heatmap written to " << fileName << std::endl;
+}
+
+}  // namespace bm_heatmap
@@ -0,0 +1,68 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_HEATMAP_H_
+#define SRC_HOST_HEATMAP_H_
+
+/* C++ standard library headers */
+#include <memory>
+#include <string>
+
+/* Project's headers */
+#include "src/host/execution.h"
+
+/**
+Contains the output of the error heatmap that shows whether the wrong
+entries and the slowdowns of a run concentrate in the chunk of a replication
+and its memory bank or in an address region of the data array.
+*/
+namespace bm_heatmap {
+
+/**
+Prints the errors, the share of the updates, the finish time and the GUOPS
+of the chunk of every replication and a heatmap of the errors in all address
+regions to stdout. Every region is drawn as a character whose intensity
+grows with its number of wrong entries relative to the worst region.
+The finish times are only known if the implementation uses the launch
+engine.
+
+@param results The execution results containing the error map
+@param dataSize Number of entries in the data array
+*/
+void
+printHeatmap(std::shared_ptr<bm_execution::ExecutionResults> results,
+             size_t dataSize);
+
+/**
+Writes the values of the chunks and the regions printed by printHeatmap()
+to a JSON file. Values that are not known are written as null.
+
+@param results The execution results containing the error map
+@param dataSize Number of entries in the data array
+@param fileName Path to the JSON file
+*/
+void
+writeHeatmap(std::shared_ptr<bm_execution::ExecutionResults> results,
+             size_t dataSize, std::string const &fileName);
+
+}  // namespace bm_heatmap
+
+#endif  // SRC_HOST_HEATMAP_H_
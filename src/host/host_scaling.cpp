@@ -0,0 +1,403 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/host_scaling.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* External library headers */
+#include <pthread.h>
+#include <sched.h>
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/fpga_setup.h"
+#include "src/host/random_access_functionality.h"
+#include "src/host/random_streams.h"
+#include "src/host/statistics.h"
+#include "src/host/trace.h"
+#include "src/host/verification.h"
+
+namespace bm_scaling {
+
+/*
+A CPU the process may run on and its position in the topology
+*/
+struct CPU {
+    int id;
+    int package;
+    int core;
+    int sibling;
+    int coreRank;
+};
+
+/*
+Reads a value of the topology of a CPU from sysfs or returns the fallback
+if it is not available
+*/
+static int
+readTopology(int cpu, std::string const &name, int fallback) {
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu)
+                       + "/topology/" + name);
+    int value;
+    if (file >> value) {
+        return value;
+    }
+    return fallback;
+}
+
+/*
+Returns the first item of the part of size items that is processed by the
+given thread
+*/
+static size_t
+partStart(size_t size, uint threads, uint thread) {
+    return size * thread / threads;
+}
+
+/*
+Executes work(t) for every thread t concurrently and returns after all
+threads are finished. The threads pin themselves to their CPU before the
+work is started, so the data is touched first on the right socket.
+*/
+static void
+runParallel(uint threads, std::vector<int> const &cpus,
+            std::function<void(uint)> const &work) {
+    std::vector<std::thread> workers;
+    for (uint t = 0; t < threads; t++) {
+        workers.push_back(std::thread([&cpus, &work, t]() {
+            if (!cpus.empty()) {
+                cpu_set_t cpuSet;
+                CPU_ZERO(&cpuSet);
+                CPU_SET(cpus[t % cpus.size()], &cpuSet);
+                pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t),
+                                       &cpuSet);
+            }
+            work(t);
+        }));
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+/*
+Applies count updates of the update sequence starting after the first
+updates to the data array. Most updates are applied with the random
+streams, the remainder with a single stream.
+*/
+static void
+applyUpdateRange(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+                 bm_distribution::AddressMap const &addressOf,
+                 DATA_TYPE_UNSIGNED first, DATA_TYPE_UNSIGNED count) {
+    DATA_TYPE_UNSIGNED streamed = count - count % RANDOM_STREAMS;
+    if (streamed > 0) {
+        DATA_TYPE_UNSIGNED states[RANDOM_STREAMS];
+        bm_random::seedStreams(states, first, streamed / RANDOM_STREAMS);
+        bm_random::applyUpdates(data, dataSize, addressOf, states,
+                                streamed / RANDOM_STREAMS, true, 1);
+    }
+    DATA_TYPE_UNSIGNED ran = starts(first + streamed);
+    for (DATA_TYPE_UNSIGNED i = streamed; i < count; i++) {
+        DATA_TYPE v = 0;
+        if (((DATA_TYPE) ran) < 0) {
+            v = POLY;
+        }
+        ran = (ran << 1) ^ v;
+        DATA_TYPE_UNSIGNED* entry = data + addressOf(ran) * ENTRY_WIDTH;
+        for (int w = 0; w < ENTRY_WIDTH; w++) {
+            entry[w] ^= ran;
+        }
+    }
+}
+
+/*
+Counts the entries of a part of the data array with at least one word that
+does not contain its own index
+*/
+static size_t
+countPartErrors(DATA_TYPE_UNSIGNED const* data, size_t begin, size_t end) {
+    size_t errors = 0;
+    for (size_t i = begin * ENTRY_WIDTH; i < end * ENTRY_WIDTH;
+            i += ENTRY_WIDTH) {
+        for (int w = 0; w < ENTRY_WIDTH; w++) {
+            if (data[i + w] != i + w) {
+                errors++;
+                break;
+            }
+        }
+    }
+    return errors;
+}
+
+/*
+ @copydoc bm_scaling::isPinningPolicy()
+*/
+bool
+isPinningPolicy(std::string const &pinning) {
+    return pinning == "none" || pinning == "compact" || pinning == "scatter";
+}
+
+/*
+ @copydoc bm_scaling::orderCPUs()
+*/
+std::vector<int>
+orderCPUs(std::string const &pinning) {
+    std::vector<int> ids;
+    if (pinning == "none") {
+        return ids;
+    }
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0) {
+        throw std::runtime_error("Could not get the CPUs of the process");
+    }
+    std::vector<CPU> cpus;
+    for (int c = 0; c < CPU_SETSIZE; c++) {
+        if (CPU_ISSET(c, &allowed)) {
+            cpus.push_back({c, readTopology(c, "physical_package_id", 0),
+                            readTopology(c, "core_id", c), 0, 0});
+        }
+    }
+
+    // Compact order: sockets, then cores, then SMT siblings of a core
+    std::sort(cpus.begin(), cpus.end(), [](CPU const &a, CPU const &b) {
+        if (a.package != b.package) {
+            return a.package < b.package;
+        }
+        if (a.core != b.core) {
+            return a.core < b.core;
+        }
+        return a.id < b.id;
+    });
+    for (size_t i = 1; i < cpus.size(); i++) {
+        CPU const &previous = cpus[i - 1];
+        if (cpus[i].package != previous.package) {
+            continue;
+        }
+        if (cpus[i].core == previous.core) {
+            cpus[i].sibling = previous.sibling + 1;
+            cpus[i].coreRank = previous.coreRank;
+        } else {
+            cpus[i].coreRank = previous.coreRank + 1;
+        }
+    }
+
+    // Scatter order: first SMT sibling of every core round-robin over the
+    // sockets, then the next siblings
+    if (pinning == "scatter") {
+        std::stable_sort(cpus.begin(), cpus.end(),
+                         [](CPU const &a, CPU const &b) {
+            if (a.sibling != b.sibling) {
+                return a.sibling < b.sibling;
+            }
+            if (a.coreRank != b.coreRank) {
+                return a.coreRank < b.coreRank;
+            }
+            return a.package < b.package;
+        });
+    }
+    for (CPU const &cpu : cpus) {
+        ids.push_back(cpu.id);
+    }
+    return ids;
+}
+
+/*
+ @copydoc bm_scaling::measureScaling()
+*/
+std::shared_ptr<ScalingResults>
+measureScaling(size_t dataSize, std::vector<cl_uint> const &blockTable,
+               uint threads, uint repetitions, std::vector<int> const &cpus) {
+    TRACE_SCOPE("scaling measurement");
+    // The map is shared by all threads
+    bm_distribution::AddressMap addressOf(dataSize, blockTable);
+    DATA_TYPE_UNSIGNED* data;
+    if (posix_memalign(reinterpret_cast<void **>(&data), 64,
+                       ENTRY_SIZE * dataSize) != 0) {
+        throw std::runtime_error("Could not allocate "
+                                 + std::to_string(ENTRY_SIZE * dataSize)
+                                 + " Byte for the data array");
+    }
+    DATA_TYPE_UNSIGNED updates = 4L * dataSize;
+
+    std::vector<double> updateTimes;
+    std::vector<double> verifyTimes;
+    size_t maxErrors = 0;
+    for (uint r = 0; r < repetitions; r++) {
+        runParallel(threads, cpus, [data, dataSize, threads](uint t) {
+            size_t begin = partStart(dataSize, threads, t);
+            size_t end = partStart(dataSize, threads, t + 1);
+            bm_verification::initializeData(data + begin * ENTRY_WIDTH,
+                                            end - begin, begin);
+        });
+
+        auto update = [data, dataSize, &addressOf, updates, threads](uint t) {
+            DATA_TYPE_UNSIGNED begin = partStart(updates, threads, t);
+            DATA_TYPE_UNSIGNED end = partStart(updates, threads, t + 1);
+            applyUpdateRange(data, dataSize, addressOf, begin, end - begin);
+        };
+        auto startTime = std::chrono::high_resolution_clock::now();
+        runParallel(threads, cpus, update);
+        auto updateTime = std::chrono::high_resolution_clock::now();
+
+        // The updates are their own inverse, so they are replayed to
+        // restore the initial data array
+        std::vector<size_t> errors(threads, 0);
+        runParallel(threads, cpus, update);
+        runParallel(threads, cpus, [data, dataSize, threads, &errors](uint t) {
+            errors[t] = countPartErrors(data,
+                                        partStart(dataSize, threads, t),
+                                        partStart(dataSize, threads, t + 1));
+        });
+        auto verifyTime = std::chrono::high_resolution_clock::now();
+
+        updateTimes.push_back(std::chrono::duration_cast<
+                    std::chrono::duration<double>>(updateTime - startTime)
+                    .count());
+        verifyTimes.push_back(std::chrono::duration_cast<
+                    std::chrono::duration<double>>(verifyTime - updateTime)
+                    .count());
+        size_t totalErrors = 0;
+        for (size_t e : errors) {
+            totalErrors += e;
+        }
+        maxErrors = std::max(maxErrors, totalErrors);
+    }
+    free(reinterpret_cast<void *>(data));
+
+    double errorRate = static_cast<double>(maxErrors) / dataSize;
+    return std::shared_ptr<ScalingResults>(new ScalingResults {
+            threads, dataSize,
+            std::shared_ptr<bm_execution::ExecutionResults>(
+                new bm_execution::ExecutionResults {updateTimes, errorRate,
+                                                    nullptr, nullptr}),
+            std::shared_ptr<bm_execution::ExecutionResults>(
+                new bm_execution::ExecutionResults {verifyTimes, errorRate,
+                                                    nullptr, nullptr})});
+}
+
+/*
+Prints a scaling table of one engine. The speedup is given relative to the
+GUOPS of the first row.
+*/
+static void
+printScalingTable(std::string const &title,
+                  std::vector<std::shared_ptr<ScalingResults>> const &results,
+                  bool useVerify) {
+    std::cout << title << ":" << std::endl;
+    std::cout << std::setw(ENTRY_SPACE) << "threads"
+              << std::setw(ENTRY_SPACE) << "items"
+              << std::setw(ENTRY_SPACE) << "best"
+              << std::setw(ENTRY_SPACE) << "mean"
+              << std::setw(ENTRY_SPACE) << "GUOPS"
+              << std::setw(ENTRY_SPACE) << "error"
+              << std::setw(ENTRY_SPACE) << "speedup"
+              << std::setw(ENTRY_SPACE) << "efficiency" << std::endl;
+    double firstGuops = 0;
+    for (std::shared_ptr<ScalingResults> const &result : results) {
+        std::shared_ptr<bm_execution::ExecutionResults> engine =
+                                    useVerify ? result->verify : result->update;
+        double tmin = *std::min_element(engine->times.begin(),
+                                        engine->times.end());
+        double gups = static_cast<double>(4 * result->dataSize) / 1000000000;
+        double guops = gups / tmin;
+        if (firstGuops == 0) {
+            firstGuops = guops;
+        }
+        double speedup = guops / firstGuops;
+        std::cout << std::setw(ENTRY_SPACE) << result->threads
+                  << std::setw(ENTRY_SPACE) << result->dataSize
+                  << std::setw(ENTRY_SPACE) << tmin
+                  << std::setw(ENTRY_SPACE)
+                  << bm_statistics::mean(engine->times)
+                  << std::setw(ENTRY_SPACE) << guops
+                  << std::setw(ENTRY_SPACE) << (100.0 * engine->errorRate)
+                  << std::setw(ENTRY_SPACE) << speedup
+                  << std::setw(ENTRY_SPACE)
+                  << speedup * results.front()->threads / result->threads
+                  << std::endl;
+    }
+}
+
+/*
+ @copydoc bm_scaling::runScalingStudy()
+*/
+void
+runScalingStudy(size_t dataSize, std::vector<cl_uint> const &blockTable,
+                uint maxThreads, uint repetitions,
+                std::string const &pinning) {
+    std::vector<int> cpus = orderCPUs(pinning);
+    std::vector<uint> threadCounts;
+    for (uint t = 1; t < maxThreads; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::cout << PROGRAM_DESCRIPTION << std::endl << HLINE;
+    std::cout << "Host scaling study:" << std::endl
+              << "Repetitions:         " << repetitions << std::endl
+              << "Data size:           " << (dataSize
+                                            * ENTRY_SIZE) * 1.0
+                                         << " Byte" << std::endl
+              << "Maximum threads:     " << maxThreads << std::endl
+              << "Hardware threads:    "
+              << std::thread::hardware_concurrency() << std::endl
+              << "Pinning:             " << pinning << std::endl
+              << "Random streams:      " << bm_random::instructionSet()
+              << std::endl << HLINE;
+
+    std::vector<std::shared_ptr<ScalingResults>> strong;
+    std::vector<std::shared_ptr<ScalingResults>> weak;
+    for (uint threads : threadCounts) {
+        strong.push_back(measureScaling(dataSize, blockTable, threads,
+                                        repetitions, cpus));
+        // The data array has to be a power of two
+        size_t weakSize = dataSize;
+        while (weakSize * 2 <= dataSize * threads) {
+            weakSize *= 2;
+        }
+        weak.push_back(measureScaling(weakSize, blockTable, threads,
+                                      repetitions, cpus));
+    }
+
+    printScalingTable("Strong scaling of the updates", strong, false);
+    printScalingTable("Strong scaling of the verification", strong, true);
+    std::cout << HLINE;
+    printScalingTable("Weak scaling of the updates", weak, false);
+    printScalingTable("Weak scaling of the verification", weak, true);
+}
+
+}  // namespace bm_scaling
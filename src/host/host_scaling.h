@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_HOST_SCALING_H_
+#define SRC_HOST_HOST_SCALING_H_
+
+/* C++ standard library headers */
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/execution.h"
+#include "src/host/random_access_definitions.h"
+
+/**
+Contains the thread-scaling study of the host-side engines. The updates of
+the benchmark and the verification pass are executed on the CPU with an
+increasing number of threads to see how the host code scales with cores,
+SMT and sockets.
+*/
+namespace bm_scaling {
+
+/**
+The measured times of both host-side engines for a number of threads
+*/
+struct ScalingResults {
+    uint threads;
+    size_t dataSize;
+    std::shared_ptr<bm_execution::ExecutionResults> update;
+    std::shared_ptr<bm_execution::ExecutionResults> verify;
+};
+
+/**
+Checks if the given pinning policy is known
+
+@param pinning The name of the policy
+
+@return true, if the policy is none, compact or scatter
+*/
+bool
+isPinningPolicy(std::string const &pinning);
+
+/**
+Orders the CPUs the process is allowed to run on for the given pinning
+policy. Thread t is pinned to the CPU at position t modulo the number of
+CPUs. compact fills the cores of a socket including their SMT siblings
+before the next socket is used. scatter distributes the threads round-robin
+over the sockets and uses the SMT siblings of a core last.
+The topology is read from /sys/devices/system/cpu.
+
+@param pinning The pinning policy: none, compact or scatter
+
+@return The CPU ids in the order they are used. Empty for none.
+
+Throws std::runtime_error if the CPUs of the process can not be read.
+*/
+std::vector<int>
+orderCPUs(std::string const &pinning);
+
+/**
+Executes the updates of the benchmark and the verification pass on a data
+array in host memory with the given number of threads.
+The update sequence is split into equally sized parts, one per thread, that
+update the shared data array concurrently without synchronization like the
+threaded variant of HPCC RandomAccess. Updates that collide with an update
+of another thread may be lost and are reported as errors. The verification
+pass replays the updates with the same threads and counts the wrong entries.
+
+@param dataSize Number of entries in the data array. Has to be a power of
+        two.
+@param blockTable The block table of the address distribution as returned
+        by bm_distribution::createBlockTable()
+@param threads Number of threads
+@param repetitions Number of repetitions
+@param cpus The CPUs the threads are pinned to as returned by orderCPUs()
+
+@return The times of both engines and the highest error rate
+
+Throws std::runtime_error if the data array can not be allocated.
+*/
+std::shared_ptr<ScalingResults>
+measureScaling(size_t dataSize, std::vector<cl_uint> const &blockTable,
+               uint threads, uint repetitions, std::vector<int> const &cpus);
+
+/**
+Executes the scaling study for 1, 2, 4, ... and maxThreads threads and
+prints a strong-scaling table with a fixed data array and a weak-scaling
+table with a data array that grows with the number of threads for both
+engines.
+
+@param dataSize Number of entries in the data array of the strong-scaling
+        study and per thread in the weak-scaling study.
+        Has to be a power of two.
+@param blockTable The block table of the address distribution
+@param maxThreads Maximum number of threads
+@param repetitions Number of repetitions per number of threads
+@param pinning The pinning policy: none, compact or scatter
+*/
+void
+runScalingStudy(size_t dataSize, std::vector<cl_uint> const &blockTable,
+                uint maxThreads, uint repetitions,
+                std::string const &pinning);
+
+}  // namespace bm_scaling
+
+#endif  // SRC_HOST_HOST_SCALING_H_
@@ -0,0 +1,346 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/hybrid.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/fpga_setup.h"
+#include "src/host/placement.h"
+#include "src/host/random_access_definitions.h"
+#include "src/host/trace.h"
+#include "src/host/verification.h"
+
+namespace bm_execution {
+
+/*
+Applies a single update to the words of an entry like STORE_UPDATE in the
+kernels. CAS compares the first word with its initial value. GATHER only
+accumulates the words in the checksum.
+*/
+static inline void
+updateEntry(DATA_TYPE_UNSIGNED* entry, DATA_TYPE_UNSIGNED value,
+            DATA_TYPE_UNSIGNED address, int operation,
+            DATA_TYPE_UNSIGNED &checksum) {
+    if (operation == OPERATION_GATHER) {
+        for (int w = 0; w < ENTRY_WIDTH; w++) {
+            checksum ^= entry[w];
+        }
+        return;
+    }
+    if (operation == OPERATION_CAS && entry[0] != address * ENTRY_WIDTH) {
+        return;
+    }
+    for (int w = 0; w < ENTRY_WIDTH; w++) {
+        switch (operation) {
+            case OPERATION_ADD: entry[w] += value; break;
+            case OPERATION_SCATTER:
+            case OPERATION_CAS: entry[w] = value; break;
+            default: entry[w] ^= value;
+        }
+    }
+}
+
+/*
+ @copydoc bm_execution::deviceChunkSize()
+*/
+size_t
+deviceChunkSize(size_t dataSize, uint replications, double hostFraction) {
+    double chunk = std::round((1.0 - hostFraction) * dataSize / replications);
+    size_t const maxChunk = dataSize / replications - 1;
+    return std::min(maxChunk,
+                    static_cast<size_t>(std::max(1.0, chunk)));
+}
+
+/*
+ @copydoc bm_execution::applyHostUpdates()
+*/
+size_t
+applyHostUpdates(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+                 bm_distribution::AddressMap const &addressOf, size_t begin,
+                 int operation, uint threads, DATA_TYPE_UNSIGNED &checksum) {
+    TRACE_SCOPE("host updates");
+    size_t const hostSize = dataSize - begin;
+    std::vector<size_t> updates(threads, 0);
+    std::vector<DATA_TYPE_UNSIGNED> checksums(threads, 0);
+    std::vector<std::thread> workers;
+    for (uint t = 0; t < threads; t++) {
+        workers.push_back(std::thread([&, t]() {
+            DATA_TYPE_UNSIGNED const first = begin + hostSize * t / threads;
+            DATA_TYPE_UNSIGNED const size = begin + hostSize * (t + 1)
+                                            / threads - first;
+            // Keep the counters in registers to avoid false sharing
+            size_t applied = 0;
+            DATA_TYPE_UNSIGNED partial = 0;
+            DATA_TYPE_UNSIGNED ran = 1;
+            for (DATA_TYPE_UNSIGNED i = 0; i < 4L * dataSize; i++) {
+                DATA_TYPE v = 0;
+                if (((DATA_TYPE) ran) < 0) {
+                    v = POLY;
+                }
+                ran = (ran << 1) ^ v;
+                DATA_TYPE_UNSIGNED address = addressOf(ran);
+                if (address - first < size) {
+                    updateEntry(data + address * ENTRY_WIDTH, ran, address,
+                                operation, partial);
+                    applied++;
+                }
+            }
+            updates[t] = applied;
+            checksums[t] = partial;
+        }));
+    }
+    size_t total = 0;
+    checksum = 0;
+    for (uint t = 0; t < threads; t++) {
+        workers[t].join();
+        total += updates[t];
+        checksum ^= checksums[t];
+    }
+    return total;
+}
+
+/*
+ @copydoc bm_execution::calculateHybrid()
+*/
+std::shared_ptr<ExecutionResults>
+calculateHybrid(std::shared_ptr<ExecutionConfiguration> config) {
+    // int used to check for OpenCL errors
+    int err;
+    uint replications = config->replications;
+    size_t dataSize = config->dataSize;
+    uint threads = config->hostThreads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // Without a given fraction every replication and the host start with
+    // the same number of entries
+    double hostFraction = config->hostFraction > 0 ? config->hostFraction
+                                                : 1.0 / (replications + 1);
+    // Created before the device is used, so an invalid block table is
+    // reported before the host threads are started
+    bm_distribution::AddressMap addressOf(dataSize, config->blockTable);
+
+    reportProgress(*config, "prepare", 0, 1);
+    DATA_TYPE_UNSIGNED* data;
+    posix_memalign(reinterpret_cast<void **>(&data), 64,
+                   ENTRY_SIZE * dataSize);
+
+    // The buffers have the size of the chunks without co-execution, so the
+    // split can be changed by the auto-balance
+    std::vector<cl::Buffer> Buffer_data = createDataBuffers(config,
+                                                    dataSize / replications);
+    std::vector<cl::CommandQueue> compute_queue;
+    std::vector<cl::Buffer> Buffer_checksum;
+    std::vector<cl::Buffer> Buffer_block_table;
+    std::vector<cl::Kernel> accesskernel;
+    for (uint r = 0; r < replications; r++) {
+        compute_queue.push_back(cl::CommandQueue(config->context,
+                                    config->device,
+                                    bm_trace::queueProperties()));
+        accesskernel.push_back(cl::Kernel(config->program,
+                    (RANDOM_ACCESS_KERNEL + std::to_string(r)).c_str(),
+                    &err));
+        ASSERT_CL(err);
+        err = accesskernel[r].setArg(0, Buffer_data[r]);
+        ASSERT_CL(err);
+        err = accesskernel[r].setArg(1, DATA_TYPE_UNSIGNED(dataSize));
+        ASSERT_CL(err);
+        if (config->operation == OPERATION_GATHER) {
+            std::vector<DATA_TYPE_UNSIGNED> zeros(UPDATE_SPLIT * ENTRY_WIDTH,
+                                                  0);
+            Buffer_checksum.push_back(cl::Buffer(config->context,
+                        CL_MEM_WRITE_ONLY, ENTRY_SIZE * UPDATE_SPLIT));
+            compute_queue[r].enqueueWriteBuffer(Buffer_checksum[r],
+                        CL_TRUE, 0, ENTRY_SIZE * UPDATE_SPLIT, zeros.data());
+            err = accesskernel[r].setArg(3, Buffer_checksum[r]);
+            ASSERT_CL(err);
+        }
+#ifdef ADDRESS_DISTRIBUTION
+        std::vector<cl_uint> table =
+                    bm_distribution::deviceBlockTable(config->blockTable);
+        Buffer_block_table.push_back(cl::Buffer(config->context,
+                        CL_MEM_READ_ONLY, sizeof(cl_uint) * table.size()));
+        compute_queue[r].enqueueWriteBuffer(Buffer_block_table[r],
+                        CL_TRUE, 0, sizeof(cl_uint) * table.size(),
+                        table.data());
+        err = accesskernel[r].setArg(
+                        config->operation == OPERATION_GATHER ? 4 : 3,
+                        Buffer_block_table[r]);
+        ASSERT_CL(err);
+#endif
+    }
+
+    // The chunk size given to the kernels also moves the start of their
+    // address range, so the device updates the entries before the host part
+    size_t chunk = 0;
+    auto setChunkSize = [&](size_t chunkSize) {
+        chunk = chunkSize;
+        for (uint r = 0; r < replications; r++) {
+            err = accesskernel[r].setArg(2, DATA_TYPE_UNSIGNED(chunk));
+            ASSERT_CL(err);
+        }
+    };
+    auto uploadChunks = [&]() {
+        for (uint r = 0; r < replications; r++) {
+            compute_queue[r].enqueueWriteBuffer(Buffer_data[r], CL_TRUE, 0,
+                                ENTRY_SIZE * chunk,
+                                data + r * chunk * ENTRY_WIDTH);
+        }
+    };
+    auto downloadChunks = [&]() {
+        for (uint r = 0; r < replications; r++) {
+            compute_queue[r].enqueueReadBuffer(Buffer_data[r], CL_TRUE, 0,
+                                ENTRY_SIZE * chunk,
+                                data + r * chunk * ENTRY_WIDTH);
+        }
+    };
+
+    // Executes the kernels and the host engine together once and returns
+    // the number of updates applied on the host. Every execution starts
+    // from the initial data, so only the last execution is verified.
+    double deviceTime = 0;
+    double hostTime = 0;
+    double totalTime = 0;
+    DATA_TYPE_UNSIGNED hostChecksum = 0;
+    auto execute = [&]() {
+        bm_verification::initializeData(data, dataSize, 0);
+        uploadChunks();
+        std::vector<cl::Event> kernelEvents(replications);
+        double enqueueTime = bm_trace::now();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (uint r = 0; r < replications; r++) {
+            compute_queue[r].enqueueTask(accesskernel[r], NULL,
+                                         &kernelEvents[r]);
+            compute_queue[r].flush();
+        }
+        std::thread deviceWait([&]() {
+            for (uint r = 0; r < replications; r++) {
+                compute_queue[r].finish();
+            }
+            deviceTime = std::chrono::duration_cast<
+                            std::chrono::duration<double>>(
+                    std::chrono::high_resolution_clock::now() - t1).count();
+        });
+        size_t hostUpdates = applyHostUpdates(data, dataSize, addressOf,
+                                              replications * chunk,
+                                              config->operation, threads,
+                                              hostChecksum);
+        hostTime = std::chrono::duration_cast<
+                        std::chrono::duration<double>>(
+                std::chrono::high_resolution_clock::now() - t1).count();
+        deviceWait.join();
+        totalTime = std::max(deviceTime, hostTime);
+        for (uint r = 0; r < replications; r++) {
+            bm_trace::addCLEvent("kernel " + std::to_string(r),
+                                 kernelEvents[r], r, enqueueTime);
+        }
+        return hostUpdates;
+    };
+
+    setChunkSize(deviceChunkSize(dataSize, replications, hostFraction));
+    reportProgress(*config, "prepare", 1, 1);
+
+    // Calibrate the split until both sides need the same time. If the
+    // entries of a side are updated with a constant rate, the new split
+    // lets both sides finish together.
+    if (config->balanceHybrid) {
+        for (uint b = 0; b < HYBRID_BALANCE_ROUNDS; b++) {
+            execute();
+            reportProgress(*config, "balance", b + 1, HYBRID_BALANCE_ROUNDS);
+            if (std::abs(deviceTime - hostTime)
+                    < HYBRID_BALANCE_TOLERANCE * totalTime) {
+                break;
+            }
+            double deviceRate = replications * chunk / deviceTime;
+            double hostRate = (dataSize - replications * chunk) / hostTime;
+            setChunkSize(deviceChunkSize(dataSize, replications,
+                                    hostRate / (deviceRate + hostRate)));
+        }
+    }
+
+    std::shared_ptr<HybridResults> hybrid(new HybridResults {
+                            replications * chunk,
+                            dataSize - replications * chunk, 0, 0, threads,
+                            {}, {}});
+    std::vector<double> times;
+    uint total = config->warmupRepetitions + config->repetitions;
+    for (uint i = 0; i < total; i++) {
+        size_t hostUpdates = execute();
+        if (i >= config->warmupRepetitions) {
+            times.push_back(totalTime);
+            hybrid->deviceTimes.push_back(deviceTime);
+            hybrid->hostTimes.push_back(hostTime);
+        }
+        hybrid->hostUpdates = hostUpdates;
+        hybrid->deviceUpdates = 4 * dataSize - hostUpdates;
+        reportProgress(*config, "execute", i + 1, total);
+    }
+
+    /* --- Check Results --- */
+
+    reportProgress(*config, "verify", 0, 1);
+    downloadChunks();
+    size_t errors = bm_verification::verifyData(data, dataSize,
+                                                config->blockTable,
+                                                config->operation, 1,
+                                                nullptr);
+    if (config->operation == OPERATION_GATHER) {
+        // The updates of a replication are split between both sides, so
+        // only the checksum of all updates is compared
+        DATA_TYPE_UNSIGNED checksum = hostChecksum;
+        for (uint r = 0; r < replications; r++) {
+            std::vector<DATA_TYPE_UNSIGNED> partial(UPDATE_SPLIT * ENTRY_WIDTH);
+            compute_queue[r].enqueueReadBuffer(Buffer_checksum[r], CL_TRUE, 0,
+                     ENTRY_SIZE * UPDATE_SPLIT, partial.data());
+            for (DATA_TYPE_UNSIGNED value : partial) {
+                checksum ^= value;
+            }
+        }
+        if (checksum != bm_verification::calculateChecksums(dataSize,
+                                                config->blockTable, 1)[0]) {
+            errors += dataSize;
+        }
+    }
+    free(reinterpret_cast<void *>(data));
+    reportProgress(*config, "verify", 1, 1);
+
+    return std::shared_ptr<ExecutionResults>(
+        new ExecutionResults {times,
+                              static_cast<double>(errors) / dataSize,
+                              nullptr, nullptr, hybrid});
+}
+
+}  // namespace bm_execution
@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_HYBRID_H_
+#define SRC_HOST_HYBRID_H_
+
+/* C++ standard library headers */
+#include <memory>
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/execution.h"
+#include "src/host/random_access_definitions.h"
+
+/**
+Maximum number of calibration executions of the auto-balance before the
+measurement
+*/
+#ifndef HYBRID_BALANCE_ROUNDS
+#define HYBRID_BALANCE_ROUNDS 4
+#endif
+
+/**
+Relative difference of the device and host times below which the
+auto-balance stops early
+*/
+#ifndef HYBRID_BALANCE_TOLERANCE
+#define HYBRID_BALANCE_TOLERANCE 0.05
+#endif
+
+namespace bm_execution {
+
+/**
+Calculates the number of entries in the data chunk of every replication on
+the device for the given fraction of the data array on the host. The host
+gets at least one entry per replication.
+
+@param dataSize Number of entries in the data array
+@param replications Number of kernel replications
+@param hostFraction Fraction of the entries that are updated on the host
+
+@return Number of entries in the chunk of every replication
+*/
+size_t
+deviceChunkSize(size_t dataSize, uint replications, double hostFraction);
+
+/**
+Applies all updates of a kernel execution to the entries from begin to the
+end of the data array with the given number of threads. Every thread walks
+the whole update sequence and only applies the updates of its own part of
+the entries, like the kernel replications do, so the updates of the host are
+applied in order and without errors.
+
+@param data The whole data array
+@param dataSize Number of entries in the data array. Has to be a power of
+        two.
+@param addressOf The address map of the data array
+@param begin The first entry that is updated on the host
+@param operation The operation of the updates, e.g. OPERATION_XOR
+@param threads Number of host threads
+@param checksum Only for OPERATION_GATHER: XOR of all loaded words
+
+@return Number of applied updates
+*/
+size_t
+applyHostUpdates(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+                 bm_distribution::AddressMap const &addressOf, size_t begin,
+                 int operation, uint threads, DATA_TYPE_UNSIGNED &checksum);
+
+/**
+Executes the benchmark on the device and a multi-threaded engine on the host
+together. The last config->hostFraction of the data array is updated on the
+host and the rest is split into equal chunks for the kernel replications
+like in calculateSingle(). Both sides walk the same update sequence, so every
+update is applied exactly once by the side that owns its address.
+If config->balanceHybrid is set, the split is adjusted in calibration
+executions before the measurement until the device and host finish at the
+same time. The calibration executions are counted like warm-up executions.
+Soak runs, the adaptive repetitions and the bandwidth and latency
+measurements are not supported.
+The measured times are the times until both sides are finished.
+
+@copydoc bm_execution::calculate()
+*/
+std::shared_ptr<ExecutionResults>
+calculateHybrid(std::shared_ptr<ExecutionConfiguration> config);
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_HYBRID_H_
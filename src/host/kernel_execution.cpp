@@ -0,0 +1,228 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UPDATE_SPLIT
+#define UPDATE_SPLIT 8
+#endif
+
+/* Related header files */
+#include "src/host/kernel_execution.h"
+
+/* C++ standard library headers */
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/bandwidth.h"
+#include "src/host/fpga_setup.h"
+#include "src/host/latency.h"
+#include "src/host/launch_engine.h"
+#include "src/host/placement.h"
+#include "src/host/random_access_definitions.h"
+#include "src/host/repetition_control.h"
+#include "src/host/trace.h"
+#include "src/host/verification.h"
+
+namespace bm_execution {
+
+/*
+ @copydoc bm_execution::executeKernels()
+*/
+std::shared_ptr<ExecutionResults>
+executeKernels(std::shared_ptr<ExecutionConfiguration> config,
+               KernelArguments const &setArguments, size_t workItems) {
+    // int used to check for OpenCL errors
+    int err;
+    uint replications = config->replications;
+    size_t dataSize = config->dataSize;
+
+    std::vector<cl::CommandQueue> compute_queue;
+    std::vector<cl::Buffer> Buffer_checksum;
+    std::vector<cl::Kernel> accesskernel;
+    std::vector<DATA_TYPE_UNSIGNED*> data_sets;
+
+    /* --- Prepare kernels --- */
+
+    std::vector<cl::Buffer> Buffer_data = createDataBuffers(config,
+                                                dataSize / replications);
+
+    for (int r=0; r < replications; r++) {
+        TRACE_SCOPE("prepare replication");
+        reportProgress(*config, "prepare", r, replications);
+        DATA_TYPE_UNSIGNED* data;
+        posix_memalign(reinterpret_cast<void **>(&data), 64,
+                       ENTRY_SIZE * (dataSize / replications));
+        data_sets.push_back(data);
+
+        compute_queue.push_back(cl::CommandQueue(config->context,
+                                    config->device,
+                                    bm_trace::queueProperties()));
+
+        accesskernel.push_back(cl::Kernel(config->program,
+                    (RANDOM_ACCESS_KERNEL + std::to_string(r)).c_str() ,
+                    &err));
+        ASSERT_CL(err);
+
+        // prepare kernels
+        err = accesskernel[r].setArg(0, Buffer_data[r]);
+        ASSERT_CL(err);
+        cl_uint checksumArg = setArguments(accesskernel[r], compute_queue[r],
+                                           r);
+
+        // The kernels return the XOR of all loaded items for GATHER
+        if (config->operation == OPERATION_GATHER) {
+            std::vector<DATA_TYPE_UNSIGNED> zeros(
+                                        UPDATE_SPLIT * ENTRY_WIDTH, 0);
+            Buffer_checksum.push_back(cl::Buffer(config->context,
+                        CL_MEM_WRITE_ONLY, ENTRY_SIZE * UPDATE_SPLIT));
+            compute_queue[r].enqueueWriteBuffer(Buffer_checksum[r],
+                        CL_TRUE, 0, ENTRY_SIZE * UPDATE_SPLIT,
+                        zeros.data());
+            err = accesskernel[r].setArg(checksumArg, Buffer_checksum[r]);
+            ASSERT_CL(err);
+        }
+    }
+
+    /* --- Measure sequential bandwidth baseline --- */
+
+    std::shared_ptr<BandwidthResults> bandwidthResults;
+    if (config->measureBandwidth) {
+        reportProgress(*config, "bandwidth", 0, 1);
+        bandwidthResults = measureBandwidth(config, compute_queue,
+                                            Buffer_data);
+    }
+
+    /* --- Measure latency of dependent reads --- */
+
+    std::shared_ptr<LatencyResults> latencyResults;
+    if (config->measureLatency) {
+        reportProgress(*config, "latency", 0, 1);
+        latencyResults = measureLatency(config, compute_queue,
+                                        Buffer_data);
+    }
+
+    /* --- Execute actual benchmark kernels --- */
+
+    LaunchEngine launchEngine(compute_queue, accesskernel, workItems,
+                              config->serialLaunch);
+    RepetitionControl repetitionControl(config, 4.0 * dataSize);
+    std::vector<cl::Buffer> Buffer_initial;
+    while (repetitionControl.next()) {
+        // prepare data and send them to device
+        if (repetitionControl.initializeData()) {
+            for (DATA_TYPE_UNSIGNED r =0; r < replications; r++) {
+                bm_verification::initializeData(data_sets[r],
+                                        dataSize / replications,
+                                        r*(dataSize / replications));
+            }
+            for (int r=0; r < replications; r++) {
+                cl::Event writeEvent;
+                double enqueueTime = bm_trace::now();
+                compute_queue[r].enqueueWriteBuffer(Buffer_data[r],
+                     CL_TRUE, 0,
+                     ENTRY_SIZE * (dataSize / replications),
+                     data_sets[r], NULL, &writeEvent);
+                bm_trace::addCLEvent("write data", writeEvent, r,
+                                     enqueueTime);
+            }
+            if (config->soakDuration > 0) {
+                Buffer_initial = copyDataBuffers(config, compute_queue,
+                                    Buffer_data, dataSize / replications);
+            }
+        } else {
+            restoreDataBuffers(compute_queue, Buffer_initial, Buffer_data,
+                               dataSize / replications);
+        }
+
+        // Execute benchmark kernels
+        double enqueueTime = bm_trace::now();
+        LaunchTimes launchTimes = launchEngine.execute();
+        bm_trace::addEvent("kernel execution", enqueueTime,
+                           bm_trace::now() - enqueueTime, TRACE_HOST_TID);
+        for (int r=0; r < replications; r++) {
+            bm_trace::addCLEvent("kernel " + std::to_string(r),
+                                 launchEngine.events()[r], r,
+                                 enqueueTime);
+        }
+        repetitionControl.addExecution(launchTimes.span);
+    }
+    repetitionControl.finish();
+
+    /* --- Read back results from Device --- */
+
+    for (int r=0; r < replications; r++) {
+        cl::Event readEvent;
+        double enqueueTime = bm_trace::now();
+        compute_queue[r].enqueueReadBuffer(Buffer_data[r], CL_TRUE, 0,
+                 ENTRY_SIZE * (dataSize / replications), data_sets[r],
+                 NULL, &readEvent);
+        bm_trace::addCLEvent("read data", readEvent, r, enqueueTime);
+    }
+    std::vector<DATA_TYPE_UNSIGNED> checksums;
+    for (int r=0; r < Buffer_checksum.size(); r++) {
+        std::vector<DATA_TYPE_UNSIGNED> partial(UPDATE_SPLIT * ENTRY_WIDTH);
+        compute_queue[r].enqueueReadBuffer(Buffer_checksum[r], CL_TRUE, 0,
+                 ENTRY_SIZE * UPDATE_SPLIT, partial.data());
+        DATA_TYPE_UNSIGNED checksum = 0;
+        for (DATA_TYPE_UNSIGNED value : partial) {
+            checksum ^= value;
+        }
+        checksums.push_back(checksum);
+    }
+    DATA_TYPE_UNSIGNED* data;
+    posix_memalign(reinterpret_cast<void **>(&data), 64,
+                                    (ENTRY_SIZE * dataSize));
+    bm_verification::mergeChunks(data_sets, data, dataSize);
+    for (size_t r =0; r < replications; r++) {
+        free(reinterpret_cast<void *>(data_sets[r]));
+    }
+
+    /* --- Check Results --- */
+
+    reportProgress(*config, "verify", 0, 1);
+    std::shared_ptr<ErrorMap> errorMap = createErrorMap(*config);
+    size_t errors = bm_verification::verifyData(data, dataSize,
+                config->blockTable, config->operation, 1,
+                errorMap.get());
+    if (config->operation == OPERATION_GATHER) {
+        errors += bm_verification::countChecksumErrors(checksums,
+                                            dataSize, config->blockTable,
+                                            errorMap.get());
+    }
+    free(reinterpret_cast<void *>(data));
+
+    std::shared_ptr<ExecutionResults> results(
+                    new ExecutionResults{repetitionControl.getTimes(),
+                                         static_cast<double>(errors)
+                                                            / dataSize,
+                                         bandwidthResults,
+                                         latencyResults});
+    results->launch = launchEngine.summary(config->warmupRepetitions);
+    results->errorMap = errorMap;
+    return results;
+}
+
+}  // namespace bm_execution
@@ -0,0 +1,76 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_KERNEL_EXECUTION_H_
+#define SRC_HOST_KERNEL_EXECUTION_H_
+
+/* C++ standard library headers */
+#include <functional>
+#include <memory>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/execution.h"
+
+namespace bm_execution {
+
+/**
+Sets the arguments of the kernel of a replication that depend on the kernel
+type. The data buffer is always the first argument and is set by
+executeKernels(), like the checksum of OPERATION_GATHER.
+
+@param kernel The kernel of the replication
+@param queue The queue of the replication, e.g. to write the inputs of the
+        kernel
+@param replication The index of the replication
+
+@return The index of the checksum argument for OPERATION_GATHER
+*/
+typedef std::function<cl_uint(cl::Kernel &kernel, cl::CommandQueue &queue,
+                              uint replication)> KernelArguments;
+
+/**
+Executes the random access kernels of all replications on the device.
+This contains everything that is shared by the kernel types: the kernels
+and data buffers are created, the optional bandwidth and latency
+measurements are done and the kernels are executed with the repetitions of
+the configuration. Afterwards the data is read back and verified.
+
+@param config The configuration of the benchmark run
+@param setArguments Sets the arguments that depend on the kernel type
+@param workItems Number of work items of an NDRange kernel. The kernels
+        are launched as single work-item tasks if it is 0.
+
+@return The time measurements without warm-up and the error rate counted from
+        the executions
+
+Throws std::runtime_error if an OpenCL call returns an error or the kernels
+fail.
+*/
+std::shared_ptr<ExecutionResults>
+executeKernels(std::shared_ptr<ExecutionConfiguration> config,
+               KernelArguments const &setArguments, size_t workItems);
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_KERNEL_EXECUTION_H_
@@ -0,0 +1,336 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/kernel_model.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/random_access_definitions.h"
+#include "src/host/trace.h"
+#include "src/host/verification.h"
+
+namespace bm_execution {
+
+/*
+Stores the updated words of a single entry like STORE_UPDATE in the kernels.
+CAS compares the first loaded word with its initial value.
+*/
+static inline void
+storeUpdate(DATA_TYPE_UNSIGNED* entry, DATA_TYPE_UNSIGNED const* loaded,
+            DATA_TYPE_UNSIGNED value, DATA_TYPE_UNSIGNED address,
+            int operation) {
+    if (operation == OPERATION_CAS && loaded[0] != address * ENTRY_WIDTH) {
+        return;
+    }
+    for (int w = 0; w < ENTRY_WIDTH; w++) {
+        switch (operation) {
+            case OPERATION_ADD: entry[w] = loaded[w] + value; break;
+            case OPERATION_SCATTER:
+            case OPERATION_CAS: entry[w] = value; break;
+            default: entry[w] = loaded[w] ^ value;
+        }
+    }
+}
+
+/*
+Merges the value of an update into an earlier update to the same address
+like MERGE_UPDATE in the single_fwd kernel
+*/
+static inline DATA_TYPE_UNSIGNED
+mergeUpdate(DATA_TYPE_UNSIGNED first, DATA_TYPE_UNSIGNED value,
+            DATA_TYPE_UNSIGNED address, int operation) {
+    switch (operation) {
+        case OPERATION_ADD: return first + value;
+        case OPERATION_SCATTER: return value;
+        case OPERATION_CAS:
+            return (first == address * ENTRY_WIDTH) ? value : first;
+        default: return first ^ value;
+    }
+}
+
+/*
+ @copydoc bm_execution::hasKernelModel()
+*/
+bool
+hasKernelModel(std::string const &kernelType) {
+    return kernelType == "single" || kernelType == "single_fwd"
+            || kernelType == "single_sorted"
+            || kernelType == "single_cached";
+}
+
+/*
+ @copydoc bm_execution::executeKernelModel()
+*/
+void
+executeKernelModel(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+                   bm_distribution::AddressMap const &addressOf,
+                   size_t replications, int operation,
+                   std::string const &kernelType,
+                   std::vector<DATA_TYPE_UNSIGNED> &checksums,
+                   ModelStatistics &statistics) {
+    TRACE_SCOPE("kernel model");
+    DATA_TYPE_UNSIGNED const chunkSize = dataSize / replications;
+    DATA_TYPE_UNSIGNED const batches = 4L * dataSize / UPDATE_SPLIT;
+    bool const forward = kernelType == "single_fwd";
+    bool const sortBatches = kernelType == "single_sorted";
+    DATA_TYPE_UNSIGNED const cachedSize = (kernelType == "single_cached")
+            ? std::min<DATA_TYPE_UNSIGNED>(CACHE_SIZE, chunkSize) : 0;
+    std::vector<DATA_TYPE_UNSIGNED> localAddress(UPDATE_SPLIT);
+    std::vector<DATA_TYPE_UNSIGNED> loaded(UPDATE_SPLIT * ENTRY_WIDTH);
+    std::vector<DATA_TYPE_UNSIGNED> value(UPDATE_SPLIT);
+    std::vector<bool> active(UPDATE_SPLIT);
+    std::vector<int> order(UPDATE_SPLIT);
+    std::vector<DATA_TYPE_UNSIGNED> tagAddress(TAG_STORE_SIZE
+                                               * TAG_STORE_WAYS);
+    std::vector<DATA_TYPE_UNSIGNED> tagBatch(TAG_STORE_SIZE * TAG_STORE_WAYS);
+    std::vector<int> tagUpdate(TAG_STORE_SIZE * TAG_STORE_WAYS);
+
+    for (size_t r = 0; r < replications; r++) {
+        DATA_TYPE_UNSIGNED const addressStart = r * chunkSize;
+        DATA_TYPE_UNSIGNED* chunk = data + addressStart * ENTRY_WIDTH;
+        DATA_TYPE_UNSIGNED checksum = 0;
+        std::fill(tagBatch.begin(), tagBatch.end(), 0);
+        DATA_TYPE_UNSIGNED ran = 1;
+        for (DATA_TYPE_UNSIGNED i = 0; i < batches; i++) {
+            for (int ld = 0; ld < UPDATE_SPLIT; ld++) {
+                DATA_TYPE v = 0;
+                if (((DATA_TYPE) ran) < 0) {
+                    v = POLY;
+                }
+                ran = (ran << 1) ^ v;
+                value[ld] = ran;
+                localAddress[ld] = addressOf(ran) - addressStart;
+                active[ld] = localAddress[ld] < chunkSize;
+            }
+
+            // Updates to cached entries are applied in order on chip and
+            // never conflict with the batch
+            for (int ld = 0; ld < UPDATE_SPLIT && cachedSize > 0; ld++) {
+                if (!active[ld] || localAddress[ld] >= cachedSize) {
+                    continue;
+                }
+                DATA_TYPE_UNSIGNED* entry = chunk
+                                            + localAddress[ld] * ENTRY_WIDTH;
+                if (operation == OPERATION_GATHER) {
+                    for (int w = 0; w < ENTRY_WIDTH; w++) {
+                        checksum ^= entry[w];
+                    }
+                } else {
+                    std::copy_n(entry, ENTRY_WIDTH, loaded.begin());
+                    storeUpdate(entry, loaded.data(), value[ld],
+                                localAddress[ld] + addressStart, operation);
+                }
+                active[ld] = false;
+                statistics.cached++;
+            }
+
+            if (forward && operation != OPERATION_GATHER) {
+                for (int ld = 0; ld < UPDATE_SPLIT; ld++) {
+                    if (!active[ld]) {
+                        continue;
+                    }
+                    DATA_TYPE_UNSIGNED folded = 0;
+                    DATA_TYPE_UNSIGNED rest = localAddress[ld];
+                    for (int f = 0; f < TAG_STORE_FOLDS; f++) {
+                        folded ^= rest;
+                        rest /= TAG_STORE_SIZE;
+                    }
+                    size_t const set = (folded & (TAG_STORE_SIZE - 1))
+                                        * TAG_STORE_WAYS;
+                    int hit = -1;
+                    int empty = -1;
+                    for (int w = 0; w < TAG_STORE_WAYS; w++) {
+                        if (tagBatch[set + w] == i + 1) {
+                            if (tagAddress[set + w] == localAddress[ld]) {
+                                hit = w;
+                            }
+                        } else if (empty < 0) {
+                            empty = w;
+                        }
+                    }
+                    if (hit >= 0) {
+                        int const first = tagUpdate[set + hit];
+                        value[first] = mergeUpdate(value[first], value[ld],
+                                            localAddress[ld] + addressStart,
+                                            operation);
+                        active[ld] = false;
+                        statistics.forwarded++;
+                    } else if (empty >= 0) {
+                        tagBatch[set + empty] = i + 1;
+                        tagAddress[set + empty] = localAddress[ld];
+                        tagUpdate[set + empty] = ld;
+                    } else {
+                        statistics.untracked++;
+                    }
+                }
+            }
+
+            // Order in which the remaining updates are loaded and stored
+            size_t count = 0;
+            for (int ld = 0; ld < UPDATE_SPLIT; ld++) {
+                if (active[ld]) {
+                    order[count++] = ld;
+                }
+            }
+            if (sortBatches) {
+                // Updates to the same address stay in their original order
+                std::stable_sort(order.begin(), order.begin() + count,
+                                 [&localAddress](int a, int b) {
+                    return localAddress[a] < localAddress[b];
+                });
+                if (operation != OPERATION_GATHER) {
+                    size_t unique = 0;
+                    for (size_t k = 0; k < count; k++) {
+                        if (unique > 0 && localAddress[order[unique - 1]]
+                                            == localAddress[order[k]]) {
+                            int const first = order[unique - 1];
+                            value[first] = mergeUpdate(value[first],
+                                            value[order[k]],
+                                            localAddress[first] + addressStart,
+                                            operation);
+                            statistics.forwarded++;
+                        } else {
+                            order[unique++] = order[k];
+                        }
+                    }
+                    count = unique;
+                }
+            }
+
+            if (operation != OPERATION_SCATTER) {
+                for (size_t k = 0; k < count; k++) {
+                    std::copy_n(chunk + localAddress[order[k]] * ENTRY_WIDTH,
+                                ENTRY_WIDTH,
+                                loaded.begin() + order[k] * ENTRY_WIDTH);
+                }
+            }
+            for (size_t k = 0; k < count; k++) {
+                int const ld = order[k];
+                DATA_TYPE_UNSIGNED const* entry = &loaded[ld * ENTRY_WIDTH];
+                if (operation == OPERATION_GATHER) {
+                    for (int w = 0; w < ENTRY_WIDTH; w++) {
+                        checksum ^= entry[w];
+                    }
+                } else {
+                    // CAS compares with the global address of the entry
+                    storeUpdate(chunk + localAddress[ld] * ENTRY_WIDTH, entry,
+                                value[ld], localAddress[ld] + addressStart,
+                                operation);
+                }
+            }
+        }
+        checksums[r] = checksum;
+    }
+}
+
+/*
+ @copydoc bm_execution::calculateModel()
+*/
+std::shared_ptr<ExecutionResults>
+calculateModel(std::shared_ptr<ExecutionConfiguration> config) {
+    if (!hasKernelModel(config->kernelType)) {
+        throw std::runtime_error("No functional model for kernel type "
+                                 + config->kernelType);
+    }
+    reportProgress(*config, "prepare", 0, 1);
+    bm_distribution::AddressMap addressOf(config->dataSize,
+                                          config->blockTable);
+    DATA_TYPE_UNSIGNED* data;
+    if (posix_memalign(reinterpret_cast<void **>(&data), 64,
+                       ENTRY_SIZE * config->dataSize) != 0) {
+        throw std::runtime_error("Could not allocate "
+                                 + std::to_string(ENTRY_SIZE
+                                                  * config->dataSize)
+                                 + " Byte for the data array");
+    }
+    std::vector<DATA_TYPE_UNSIGNED> checksums(config->replications, 0);
+    ModelStatistics statistics {0, 0, 0};
+    reportProgress(*config, "prepare", 1, 1);
+
+    uint executions = config->warmupRepetitions + config->repetitions;
+    std::vector<double> times;
+    for (uint r = 0; r < executions; r++) {
+        // Every execution starts from the initial data
+        bm_verification::initializeData(data, config->dataSize, 0);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        executeKernelModel(data, config->dataSize, addressOf,
+                           config->replications, config->operation,
+                           config->kernelType, checksums, statistics);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        if (r >= config->warmupRepetitions) {
+            times.push_back(std::chrono::duration_cast<
+                            std::chrono::duration<double>>(t2 - t1).count());
+        }
+        reportProgress(*config, "execute", r + 1, executions);
+    }
+
+    reportProgress(*config, "verify", 0, 1);
+    std::shared_ptr<ErrorMap> errorMap = createErrorMap(*config);
+    size_t errors = 0;
+    if (config->operation == OPERATION_GATHER) {
+        errors = bm_verification::countChecksumErrors(checksums,
+                                                      config->dataSize,
+                                                      config->blockTable,
+                                                      errorMap.get());
+    } else {
+        errors = bm_verification::verifyData(data, config->dataSize,
+                                             config->blockTable,
+                                             config->operation, 1,
+                                             errorMap.get());
+    }
+    free(reinterpret_cast<void *>(data));
+    reportProgress(*config, "verify", 1, 1);
+
+    if (config->kernelType == "single_fwd") {
+        std::cout << "Forwarded updates:   " << statistics.forwarded
+                  << std::endl
+                  << "Untracked addresses: " << statistics.untracked
+                  << std::endl;
+    }
+    if (config->kernelType == "single_sorted") {
+        std::cout << "Merged updates:      " << statistics.forwarded
+                  << std::endl;
+    }
+    if (config->kernelType == "single_cached") {
+        std::cout << "Cached updates:      " << statistics.cached
+                  << std::endl;
+    }
+    std::shared_ptr<ExecutionResults> results(
+        new ExecutionResults {times,
+                              static_cast<double>(errors) / config->dataSize,
+                              nullptr, nullptr});
+    results->errorMap = errorMap;
+    return results;
+}
+
+}  // namespace bm_execution
@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_KERNEL_MODEL_H_
+#define SRC_HOST_KERNEL_MODEL_H_
+
+/* C++ standard library headers */
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/execution.h"
+#include "src/host/random_access_definitions.h"
+
+/**
+Number of updates that are loaded and stored together by the kernels
+*/
+#ifndef UPDATE_SPLIT
+#define UPDATE_SPLIT 1024
+#endif
+
+/**
+Number of sets and ways of the tag store of the single_fwd kernel. Have to
+match the values used to synthesize the kernel.
+*/
+#ifndef TAG_STORE_SIZE
+#define TAG_STORE_SIZE (2 * UPDATE_SPLIT)
+#endif
+
+#ifndef TAG_STORE_WAYS
+#define TAG_STORE_WAYS 4
+#endif
+
+/**
+Number of entries at the start of the chunk of every replication that are
+kept in on-chip memory by the single_cached kernel. Has to match the value
+used to synthesize the kernel.
+*/
+#ifndef CACHE_SIZE
+#define CACHE_SIZE 8192
+#endif
+
+/**
+Number of parts of an address that are XORed to get its set in the tag store
+*/
+#define TAG_STORE_FOLDS 4
+
+namespace bm_execution {
+
+/**
+Counters of the updates that were merged into another update of the same
+address within a batch and of the updates to cached entries
+*/
+struct ModelStatistics {
+    size_t forwarded;
+    size_t untracked;
+    size_t cached;
+};
+
+/**
+Checks if a functional model exists for the given kernel type
+
+@param kernelType The kernel type, e.g. single_fwd
+
+@return true, if the kernel type is single, single_fwd, single_sorted or
+        single_cached
+*/
+bool
+hasKernelModel(std::string const &kernelType);
+
+/**
+Executes the functional model of the single, single_fwd, single_sorted or
+single_cached kernels of all replications once. The model processes the
+updates in batches of UPDATE_SPLIT like the kernels: all items of a batch are
+loaded before they are stored, so updates to the same address within a batch
+are lost unless they are forwarded with the tag store of the single_fwd
+kernel, merged after the sort of the single_sorted kernel or applied to the
+on-chip cache of the single_cached kernel.
+
+@param data The whole data array
+@param dataSize Number of entries in the data array. Has to be a power of
+        two.
+@param addressOf The address map of the data array
+@param replications Number of kernel replications
+@param operation The operation of the updates, e.g. OPERATION_XOR
+@param kernelType The modeled kernel type
+@param checksums The checksums of all replications for OPERATION_GATHER
+@param statistics The number of forwarded or merged updates, of
+        addresses that could not be tracked because their set was full and
+        of cached updates are added to the counters
+*/
+void
+executeKernelModel(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+                   bm_distribution::AddressMap const &addressOf,
+                   size_t replications, int operation,
+                   std::string const &kernelType,
+                   std::vector<DATA_TYPE_UNSIGNED> &checksums,
+                   ModelStatistics &statistics);
+
+/**
+Implementation of calculate() that executes the functional model of the
+kernels on the host instead of a program on the device. It is used to verify
+the kernels and the effect of UPDATE_SPLIT and TAG_STORE_SIZE on the error
+without hardware. The given number of warm-up executions and repetitions is
+executed, soak runs and the adaptive repetitions are not supported.
+The measured times are the times of the model on the host.
+
+@copydoc bm_execution::calculate()
+*/
+std::shared_ptr<ExecutionResults>
+calculateModel(std::shared_ptr<ExecutionConfiguration> config);
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_KERNEL_MODEL_H_
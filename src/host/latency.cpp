@@ -0,0 +1,117 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/latency.h"
+
+/* C++ standard library headers */
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/fpga_setup.h"
+#include "src/host/random_access_definitions.h"
+#include "src/host/trace.h"
+
+namespace bm_execution {
+
+/*
+ @copydoc bm_execution::createPointerChain()
+*/
+void
+createPointerChain(DATA_TYPE_UNSIGNED* chain, size_t size) {
+    TRACE_SCOPE("create pointer chain");
+    for (size_t i = 0; i < size; i++) {
+        chain[i] = i;
+    }
+    // Sattolo's algorithm creates a single cycle over all items
+    std::mt19937_64 generator(size);
+    for (size_t i = size - 1; i > 0; i--) {
+        std::uniform_int_distribution<size_t> distribution(0, i - 1);
+        std::swap(chain[i], chain[distribution(generator)]);
+    }
+}
+
+/*
+ @copydoc bm_execution::measureLatency()
+*/
+std::shared_ptr<LatencyResults>
+measureLatency(std::shared_ptr<ExecutionConfiguration> config,
+               std::vector<cl::CommandQueue> const &queues,
+               std::vector<cl::Buffer> const &buffers) {
+    TRACE_SCOPE("latency measurement");
+    int err;
+    size_t chunkSize = config->dataSize / config->replications;
+    std::vector<cl::Kernel> kernels;
+    std::vector<cl::Buffer> resultBuffers;
+    for (int r=0; r < config->replications; r++) {
+        kernels.push_back(cl::Kernel(config->program,
+                    (LATENCY_KERNEL_NAME + std::to_string(r)).c_str(),
+                    &err));
+        ASSERT_CL(err);
+        resultBuffers.push_back(cl::Buffer(config->context,
+                    CL_MEM_WRITE_ONLY, sizeof(DATA_TYPE_UNSIGNED)));
+        err = kernels[r].setArg(0, buffers[r]);
+        ASSERT_CL(err);
+        err = kernels[r].setArg(1, DATA_TYPE_UNSIGNED(LATENCY_STEPS));
+        ASSERT_CL(err);
+        err = kernels[r].setArg(2, resultBuffers[r]);
+        ASSERT_CL(err);
+    }
+
+    std::shared_ptr<LatencyResults> results(new LatencyResults());
+    for (size_t size = LATENCY_MIN_SIZE; size <= chunkSize; size *= 4) {
+        results->sizes.push_back(size);
+    }
+    if (results->sizes.empty() || results->sizes.back() != chunkSize) {
+        results->sizes.push_back(chunkSize);
+    }
+
+    DATA_TYPE_UNSIGNED* chain;
+    posix_memalign(reinterpret_cast<void **>(&chain), 64,
+                   sizeof(DATA_TYPE_UNSIGNED) * chunkSize);
+    for (size_t size : results->sizes) {
+        createPointerChain(chain, size);
+        std::vector<double> bankLatencies;
+        for (int r=0; r < config->replications; r++) {
+            queues[r].enqueueWriteBuffer(buffers[r], CL_TRUE, 0,
+                            sizeof(DATA_TYPE_UNSIGNED) * size, chain);
+            auto t1 = std::chrono::high_resolution_clock::now();
+            queues[r].enqueueTask(kernels[r]);
+            queues[r].finish();
+            auto t2 = std::chrono::high_resolution_clock::now();
+            std::chrono::duration<double, std::nano> timespan = t2 - t1;
+            bankLatencies.push_back(timespan.count() / LATENCY_STEPS);
+        }
+        results->latencies.push_back(bankLatencies);
+    }
+    free(reinterpret_cast<void *>(chain));
+    return results;
+}
+
+}  // namespace bm_execution
@@ -0,0 +1,85 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_LATENCY_H_
+#define SRC_HOST_LATENCY_H_
+
+/* C++ standard library headers */
+#include <memory>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/execution.h"
+#include "src/host/random_access_definitions.h"
+
+/**
+Number of dependent reads done by a pointer chasing kernel per measurement
+*/
+#ifndef LATENCY_STEPS
+#define LATENCY_STEPS 1048576
+#endif
+
+/**
+Number of items of the smallest pointer chain. The size is multiplied by
+four for every following measurement until the size of the data chunk of
+a replication is reached.
+*/
+#ifndef LATENCY_MIN_SIZE
+#define LATENCY_MIN_SIZE 1024
+#endif
+
+namespace bm_execution {
+
+/**
+Creates a random cyclic permutation of the given size, so following the
+indices from any item visits all items before the start is reached again.
+
+@param chain Array that will contain the index of the next item for every
+            item
+@param size The number of items in the chain
+*/
+void
+createPointerChain(DATA_TYPE_UNSIGNED* chain, size_t size);
+
+/**
+Measures the latency of dependent reads in the memory bank of every
+replication with the pointer chasing kernels. They have to be synthesized
+with LATENCY_KERNEL defined.
+The measurement is repeated for pointer chains of increasing size.
+The content of the data buffers is overwritten by the measurement.
+
+@param config The configuration of the benchmark run
+@param queues The command queues of all replications
+@param buffers The data buffers of all replications
+
+@return The measured latencies
+*/
+std::shared_ptr<LatencyResults>
+measureLatency(std::shared_ptr<ExecutionConfiguration> config,
+               std::vector<cl::CommandQueue> const &queues,
+               std::vector<cl::Buffer> const &buffers);
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_LATENCY_H_
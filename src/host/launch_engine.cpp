@@ -0,0 +1,273 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/launch_engine.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/fpga_setup.h"
+
+namespace bm_execution {
+
+/*
+ @copydoc bm_execution::LaunchEngine::LaunchEngine()
+*/
+LaunchEngine::LaunchEngine(std::vector<cl::CommandQueue> const &queues,
+                           std::vector<cl::Kernel> const &kernels,
+                           size_t workItems, bool serial)
+        : queues(queues), kernels(kernels), workItems(workItems),
+          serial(serial), kernelEvents(queues.size()), generation(0),
+          ready(0), pending(0), stopping(false), failed(false),
+          released(false) {
+    for (size_t q = 0; q < queues.size(); q++) {
+        completions.push_back(Completion {this, q});
+    }
+    if (!serial) {
+        for (size_t q = 0; q < queues.size(); q++) {
+            workers.push_back(std::thread(&LaunchEngine::work, this, q));
+        }
+    }
+}
+
+/*
+ @copydoc bm_execution::LaunchEngine::~LaunchEngine()
+*/
+LaunchEngine::~LaunchEngine() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    armed.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+/*
+ @copydoc bm_execution::LaunchEngine::execute()
+*/
+LaunchTimes
+LaunchEngine::execute() {
+    times = LaunchTimes {0, std::vector<double>(queues.size(), 0),
+                         std::vector<double>(queues.size(), 0)};
+    if (serial) {
+        executeSerial();
+    } else {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready = 0;
+        pending = queues.size();
+        released = false;
+        generation++;
+        armed.notify_all();
+        // Release the threads together when all of them wait at the barrier
+        changed.wait(lock, [this]() { return ready == queues.size(); });
+        releaseTime = std::chrono::high_resolution_clock::now();
+        released = true;
+        changed.wait(lock, [this]() { return pending == 0; });
+        if (launchError) {
+            std::exception_ptr error = launchError;
+            launchError = nullptr;
+            failed = false;
+            std::rethrow_exception(error);
+        }
+        if (failed) {
+            failed = false;
+            throw std::runtime_error("Execution of the kernels failed");
+        }
+    }
+    times.span = *std::max_element(times.finishTimes.begin(),
+                                   times.finishTimes.end());
+    history.push_back(times);
+    return times;
+}
+
+/*
+ @copydoc bm_execution::LaunchEngine::events()
+*/
+std::vector<cl::Event> const &
+LaunchEngine::events() const {
+    return kernelEvents;
+}
+
+/*
+ @copydoc bm_execution::LaunchEngine::summary()
+*/
+std::shared_ptr<LaunchResults>
+LaunchEngine::summary(size_t warmup) const {
+    std::shared_ptr<LaunchResults> results(new LaunchResults {serial,
+                            std::vector<double>(queues.size(), 0),
+                            std::vector<double>(queues.size(), 0)});
+    if (history.size() <= warmup) {
+        return results;
+    }
+    size_t const launches = history.size() - warmup;
+    for (size_t l = warmup; l < history.size(); l++) {
+        for (size_t q = 0; q < queues.size(); q++) {
+            results->startOffsets[q] += history[l].startOffsets[q] / launches;
+            results->finishTimes[q] += history[l].finishTimes[q] / launches;
+        }
+    }
+    return results;
+}
+
+/*
+ @copydoc bm_execution::LaunchEngine::complete()
+*/
+void CL_CALLBACK
+LaunchEngine::complete(cl_event, cl_int status, void* data) {
+    Completion* completion = static_cast<Completion*>(data);
+    LaunchEngine* engine = completion->engine;
+    double finishTime = engine->elapsed();
+    {
+        std::lock_guard<std::mutex> lock(engine->mutex);
+        engine->times.finishTimes[completion->queue] = finishTime;
+        // A negative status is the error code of an aborted kernel
+        if (status < 0) {
+            engine->failed = true;
+        }
+        engine->pending--;
+    }
+    engine->changed.notify_all();
+}
+
+/*
+ @copydoc bm_execution::LaunchEngine::work()
+*/
+void
+LaunchEngine::work(size_t queue) {
+    uint64_t launched = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            armed.wait(lock, [&]() {
+                return stopping || generation != launched;
+            });
+            if (stopping) {
+                return;
+            }
+            launched = generation;
+            ready++;
+        }
+        changed.notify_all();
+        // Spin at the barrier to keep the wake-up time of the threads out
+        // of the launch skew. Yielding keeps the other threads running if
+        // there are less CPUs than queues.
+        while (!released) {
+            std::this_thread::yield();
+        }
+        try {
+            launch(queue);
+        } catch (...) {
+            // No completion callback was registered for the queue, so it is
+            // counted as done here and the error is rethrown by execute()
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!launchError) {
+                    launchError = std::current_exception();
+                }
+                pending--;
+            }
+            changed.notify_all();
+        }
+    }
+}
+
+/*
+ @copydoc bm_execution::LaunchEngine::launch()
+*/
+void
+LaunchEngine::launch(size_t queue) {
+    int err;
+    if (workItems > 0) {
+        err = queues[queue].enqueueNDRangeKernel(kernels[queue],
+                                                 cl::NullRange,
+                                                 cl::NDRange(workItems),
+                                                 cl::NDRange(1), NULL,
+                                                 &kernelEvents[queue]);
+    } else {
+        err = queues[queue].enqueueTask(kernels[queue], NULL,
+                                        &kernelEvents[queue]);
+    }
+    ASSERT_CL(err);
+    err = queues[queue].flush();
+    ASSERT_CL(err);
+    double startOffset = elapsed();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        times.startOffsets[queue] = startOffset;
+    }
+    err = kernelEvents[queue].setCallback(CL_COMPLETE, &LaunchEngine::complete,
+                                          &completions[queue]);
+    ASSERT_CL(err);
+}
+
+/*
+ @copydoc bm_execution::LaunchEngine::executeSerial()
+*/
+void
+LaunchEngine::executeSerial() {
+    releaseTime = std::chrono::high_resolution_clock::now();
+    for (size_t q = 0; q < queues.size(); q++) {
+        int err;
+        if (workItems > 0) {
+            err = queues[q].enqueueNDRangeKernel(kernels[q], cl::NullRange,
+                                                 cl::NDRange(workItems),
+                                                 cl::NDRange(1), NULL,
+                                                 &kernelEvents[q]);
+        } else {
+            err = queues[q].enqueueTask(kernels[q], NULL, &kernelEvents[q]);
+        }
+        ASSERT_CL(err);
+        times.startOffsets[q] = elapsed();
+    }
+    // The finish time of a queue also contains the waiting for the queues
+    // before it
+    for (size_t q = 0; q < queues.size(); q++) {
+        queues[q].finish();
+        times.finishTimes[q] = elapsed();
+    }
+}
+
+/*
+ @copydoc bm_execution::LaunchEngine::elapsed()
+*/
+double
+LaunchEngine::elapsed() const {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(
+                std::chrono::high_resolution_clock::now()
+                                                    - releaseTime).count();
+}
+
+}  // namespace bm_execution
@@ -0,0 +1,184 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_LAUNCH_ENGINE_H_
+#define SRC_HOST_LAUNCH_ENGINE_H_
+
+/* C++ standard library headers */
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/execution.h"
+
+namespace bm_execution {
+
+/**
+Times of a single launch of the kernels of all command queues. All times are
+given in seconds since the release of the launch.
+*/
+struct LaunchTimes {
+    // Time until the kernels of all queues finished
+    double span;
+    // Time until the kernel of every queue was submitted
+    std::vector<double> startOffsets;
+    // Time until the kernel of every queue finished
+    std::vector<double> finishTimes;
+};
+
+/**
+Launches a kernel on every command queue at the same time.
+Every queue has its own host thread. The threads wait at a barrier until all
+of them are ready and are then released together, so the kernels of all
+queues are submitted without the skew of a sequential loop. The completion
+of every kernel is collected with an event callback, so the finish time of a
+queue does not depend on the order in which the queues are waited for.
+In the serial mode the kernels are submitted in a loop and the queues are
+finished one after another from the calling thread like before.
+*/
+class LaunchEngine {
+ public:
+    /**
+    Creates the engine and starts the launch threads
+
+    @param queues The command queue of every replication
+    @param kernels The kernel that is launched on the queue with the same
+                    index
+    @param workItems Number of work items of an NDRange kernel. The kernels
+                    are launched as single work-item tasks if it is 0.
+    @param serial Launch the kernels from the calling thread one after
+                    another instead
+    */
+    LaunchEngine(std::vector<cl::CommandQueue> const &queues,
+                 std::vector<cl::Kernel> const &kernels, size_t workItems,
+                 bool serial);
+
+    /**
+    Stops and joins the launch threads
+    */
+    ~LaunchEngine();
+
+    /**
+    Launches the kernels of all queues once and waits until all of them
+    finished. Throws std::runtime_error if one of the kernels failed. If a
+    kernel could not be launched, the error of its launch thread is
+    rethrown after the other kernels finished.
+
+    @return The submission and finish times of all queues
+    */
+    LaunchTimes
+    execute();
+
+    /**
+    @return The events of the kernels of the last launch
+    */
+    std::vector<cl::Event> const &
+    events() const;
+
+    /**
+    Calculates the mean times of all launches after the given number of
+    warm-up launches
+
+    @param warmup Number of launches at the beginning that are skipped
+
+    @return The mean submission and finish time of every queue
+    */
+    std::shared_ptr<LaunchResults>
+    summary(size_t warmup) const;
+
+ private:
+    /**
+    Data passed to the event callback of a kernel
+    */
+    struct Completion {
+        LaunchEngine* engine;
+        size_t queue;
+    };
+
+    /**
+    Event callback that is called when the kernel of a queue finished.
+    The finished event is not needed, since the queue is given by the data,
+    but it is part of the signature of OpenCL event callbacks.
+
+    @param status The execution status of the kernel. Negative if it failed.
+    @param data The Completion of the queue
+    */
+    static void CL_CALLBACK
+    complete(cl_event, cl_int status, void* data);
+
+    /**
+    Loop of the launch thread of a queue
+    */
+    void
+    work(size_t queue);
+
+    /**
+    Submits the kernel of a queue and registers the event callback
+    */
+    void
+    launch(size_t queue);
+
+    /**
+    Launches the kernels one after another from the calling thread
+    */
+    void
+    executeSerial();
+
+    /**
+    @return The seconds since the release of the current launch
+    */
+    double
+    elapsed() const;
+
+    std::vector<cl::CommandQueue> queues;
+    std::vector<cl::Kernel> kernels;
+    size_t workItems;
+    bool serial;
+    std::vector<cl::Event> kernelEvents;
+    std::vector<Completion> completions;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable armed;
+    std::condition_variable changed;
+    uint64_t generation;
+    size_t ready;
+    size_t pending;
+    bool stopping;
+    bool failed;
+    std::exception_ptr launchError;
+    std::atomic<bool> released;
+    std::chrono::high_resolution_clock::time_point releaseTime;
+    LaunchTimes times;
+    std::vector<LaunchTimes> history;
+};
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_LAUNCH_ENGINE_H_
@@ -0,0 +1,331 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/random_access_functionality.h"
+
+/* C++ standard library headers */
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/benchmark_runner.h"
+#include "src/host/comparison.h"
+#include "src/host/execution.h"
+#include "src/host/fpga_setup.h"
+#include "src/host/heatmap.h"
+#include "src/host/host_scaling.h"
+#include "src/host/kernel_model.h"
+#include "src/host/perf_counters.h"
+#include "src/host/placement.h"
+#include "src/host/regression_gate.h"
+#include "src/host/trace.h"
+
+/**
+Prepares the FPGA, executes the kernels on the device and prints the results.
+The errors of the benchmark runs are thrown as std::runtime_error.
+
+@param programSettings The parsed settings of the program
+
+@return The exit code of the program
+*/
+static int
+runBenchmark(std::shared_ptr<ProgramSettings> programSettings) {
+    if (!programSettings->traceFileName.empty()) {
+        bm_trace::enable(programSettings->traceFileName);
+    }
+    // The counters of the phases outside of the runs are measured in this
+    // thread, e.g. the programming of the device
+    bm_perf::ScopedEnable perfCounters(programSettings->perfCounters);
+    std::vector<cl_uint> blockTable = bm_distribution::createBlockTable(
+                                    programSettings->distribution,
+                                    programSettings->zipfExponent,
+                                    programSettings->hotFraction,
+                                    programSettings->hotProbability,
+                                    programSettings->bankBias,
+                                    programSettings->numReplications);
+    if (programSettings->scalingThreads > 0) {
+        // Only the host code is measured, no device is needed
+        bm_scaling::runScalingStudy(programSettings->dataSize, blockTable,
+                                    programSettings->scalingThreads,
+                                    programSettings->numRepetitions,
+                                    programSettings->pinning);
+        bm_trace::write();
+        return 0;
+    }
+    fpga_setup::setupEnvironmentAndClocks();
+
+    // Load the baseline before the benchmark to fail early
+    bm_regression::BaselineRow baseline;
+    if (!programSettings->baselineKey.empty()) {
+        baseline = bm_regression::loadBaseline(
+                                        programSettings->baselineFileName,
+                                        programSettings->baselineKey,
+                                        programSettings->baselineBoard);
+    }
+
+    std::vector<cl::Device> usedDevice;
+    cl::Context context;
+    cl::Program program;
+    cl::Device device;
+
+    if (programSettings->kernelFileName != "CPU"
+            && !programSettings->useModel) {
+        usedDevice = fpga_setup::selectFPGADevice(
+                                        programSettings->defaultPlatform,
+                                        programSettings->defaultDevice);
+        context = cl::Context(usedDevice);
+        const char* usedKernel = programSettings->kernelFileName.c_str();
+        program = fpga_setup::fpgaSetup(context, usedDevice, usedKernel);
+    }
+
+
+    bool useSubBuffers = programSettings->placement == "sub-buffers";
+    std::vector<int> memoryBanks = bm_execution::assignMemoryBanks(
+                                        programSettings->placement,
+                                        programSettings->numReplications,
+                                        programSettings->numBanks);
+
+    // Give setup summary
+    std::cout << PROGRAM_DESCRIPTION << std::endl << HLINE;
+    std::cout << "Summary:" << std::endl
+              << "Kernel Replications: " << programSettings->numReplications
+              << std::endl
+              << "Repetitions:         " << programSettings->numRepetitions
+              << std::endl
+              << "Warm-up repetitions: "
+              << programSettings->numWarmupRepetitions << std::endl
+              << "Total data size:     " << (programSettings->dataSize
+                                            * ENTRY_SIZE) * 1.0
+                                         << " Byte" << std::endl
+              << "Entry size:          " << ENTRY_SIZE << " Byte"
+              << std::endl
+              << "Memory Interleaving: " << programSettings->useMemInterleaving
+              << std::endl
+              << "Placement:           "
+              << bm_execution::describePlacement(memoryBanks, useSubBuffers)
+              << std::endl
+              << "Kernel file:         " << (programSettings->useModel
+                                            ? "functional model"
+                                            : programSettings->kernelFileName)
+              << std::endl
+              << "Kernel type:         " << programSettings->kernelType
+              << std::endl
+              << "Operation:           "
+              << operationName(programSettings->operation) << std::endl
+              << "Distribution:        "
+              << bm_distribution::describeDistribution(
+                                        programSettings->distribution,
+                                        programSettings->zipfExponent,
+                                        programSettings->hotFraction,
+                                        programSettings->hotProbability,
+                                        programSettings->bankBias,
+                                        blockTable)
+              << std::endl;
+    if (programSettings->kernelType == "single_cached") {
+        std::cout << "Cached updates:      "
+                  << 100 * bm_distribution::cachedFraction(blockTable,
+                                            programSettings->dataSize,
+                                            programSettings->numReplications,
+                                            CACHE_SIZE)
+                  << "%" << std::endl;
+    }
+    if (programSettings->windowSize > 0) {
+        std::cout << "Out-of-core window:  " << (programSettings->windowSize
+                                                * ENTRY_SIZE) * 1.0
+                                             << " Byte" << std::endl;
+    }
+    if (programSettings->hostFraction > 0 || programSettings->balanceHybrid) {
+        std::cout << "Host fraction:       " << programSettings->hostFraction
+                  << (programSettings->balanceHybrid ? " (auto-balance)" : "")
+                  << std::endl;
+    }
+    if (programSettings->kernelFileNames.size() > 1) {
+        std::cout << "Compared files:      "
+                  << programSettings->kernelFileNames.size() << std::endl;
+    }
+    if (programSettings->tenants > 0) {
+        std::cout << "Tenants:             " << programSettings->tenants
+                  << " tables of " << (programSettings->dataSize
+                                       / programSettings->tenants
+                                       * ENTRY_SIZE) * 1.0
+                  << " Byte" << std::endl;
+    }
+    if (programSettings->heatmapRegions > 0) {
+        std::cout << "Heatmap regions:     " << programSettings->heatmapRegions
+                  << " of " << (programSettings->dataSize
+                                / programSettings->heatmapRegions
+                                * ENTRY_SIZE) * 1.0
+                  << " Byte" << std::endl;
+    }
+    if (programSettings->targetRSE > 0) {
+        std::cout << "Target rel. SE:      " << programSettings->targetRSE
+                  << " (max. " << programSettings->maxRepetitions
+                  << " repetitions)" << std::endl;
+    }
+    if (programSettings->soakDuration > 0) {
+        std::cout << "Soak duration:       " << programSettings->soakDuration
+                  << "s" << std::endl;
+    }
+    if (usedDevice.size() > 0) {
+        std::cout << "Device:              "
+                  << usedDevice[0].getInfo<CL_DEVICE_NAME>() << std::endl;
+        device = usedDevice[0];
+    }
+    std::cout << HLINE
+              << "Start benchmark using the given configuration." << std::endl
+              << HLINE;
+
+    bm_execution::ExecutionConfiguration config {};
+    config.context = context;
+    config.device = device;
+    config.program = program;
+    config.repetitions = programSettings->numRepetitions;
+    config.warmupRepetitions = programSettings->numWarmupRepetitions;
+    config.maxRepetitions = programSettings->maxRepetitions;
+    config.targetRSE = programSettings->targetRSE;
+    config.replications = programSettings->numReplications;
+    config.dataSize = programSettings->dataSize;
+    config.memoryBanks = memoryBanks;
+    config.useSubBuffers = useSubBuffers;
+    config.soakDuration = programSettings->soakDuration;
+    config.soakConfidence = programSettings->soakConfidence;
+    config.soakInterval = programSettings->soakInterval;
+    config.measureBandwidth = programSettings->measureBandwidth;
+    config.measureLatency = programSettings->measureLatency;
+    config.operation = programSettings->operation;
+    config.blockTable = blockTable;
+    config.windowSize = programSettings->windowSize;
+    config.tableFileName = programSettings->tableFileName;
+    config.kernelType = programSettings->kernelType;
+    config.useModel = programSettings->useModel;
+    config.hostFraction = programSettings->hostFraction;
+    config.balanceHybrid = programSettings->balanceHybrid;
+    config.hostThreads = programSettings->hostThreads;
+    config.tenants = programSettings->tenants;
+    config.serialLaunch = programSettings->serialLaunch;
+    config.heatmapRegions = programSettings->heatmapRegions;
+    config.trace = !programSettings->traceFileName.empty();
+    config.perfCounters = programSettings->perfCounters;
+
+    if (programSettings->kernelFileNames.size() > 1) {
+        // The kernel files are programmed one after another and their runs
+        // share the context and the data buffers
+        config.sharedBuffers = std::make_shared<bm_execution::SharedBuffers>();
+        std::vector<bm_comparison::ComparisonEntry> entries;
+        for (size_t f = 0; f < programSettings->kernelFileNames.size(); f++) {
+            std::string const &fileName = programSettings->kernelFileNames[f];
+            if (f > 0) {
+                config.program = fpga_setup::fpgaSetup(context, usedDevice,
+                                                       fileName);
+            }
+            bm_comparison::KernelFileInfo info =
+                    bm_comparison::detectKernelFile(config.program, fileName,
+                                                programSettings->kernelType,
+                                                programSettings->operation);
+            checkKernelSettings(*programSettings, info.kernelType,
+                                info.replications);
+            config.kernelType = info.kernelType;
+            config.replications = info.replications;
+            config.memoryBanks = bm_execution::assignMemoryBanks(
+                                        programSettings->placement,
+                                        info.replications,
+                                        programSettings->numBanks);
+            // The bank bias is given per replication of the kernel file
+            config.blockTable = bm_distribution::createBlockTable(
+                                        programSettings->distribution,
+                                        programSettings->zipfExponent,
+                                        programSettings->hotFraction,
+                                        programSettings->hotProbability,
+                                        programSettings->bankBias,
+                                        info.replications);
+            std::cout << "Kernel file:         " << fileName << std::endl
+                      << "Kernel type:         " << info.kernelType
+                      << std::endl
+                      << "Kernel Replications: " << info.replications
+                      << std::endl << HLINE;
+
+            double calculateStart = bm_trace::now();
+            bm_execution::BenchmarkRunner runner(config);
+            auto results = runner.run();
+            bm_trace::addEvent("calculate " + fileName, calculateStart,
+                               bm_trace::now() - calculateStart,
+                               TRACE_HOST_TID);
+            printResults(results, programSettings->dataSize);
+            std::cout << HLINE;
+            entries.push_back(
+                    bm_comparison::ComparisonEntry {fileName, info, results});
+        }
+        bm_comparison::printComparison(entries, programSettings->dataSize);
+        bm_trace::write();
+        return 0;
+    }
+
+    // Start actual benchmark
+    double calculateStart = bm_trace::now();
+    bm_execution::BenchmarkRunner runner(config);
+    auto results = runner.run();
+    bm_trace::addEvent("calculate", calculateStart,
+                       bm_trace::now() - calculateStart, TRACE_HOST_TID);
+
+    printResults(results, programSettings->dataSize);
+    if (!programSettings->heatmapFileName.empty()) {
+        bm_heatmap::writeHeatmap(results, programSettings->dataSize,
+                                 programSettings->heatmapFileName);
+    }
+
+    bool regression = false;
+    if (!programSettings->baselineKey.empty()) {
+        regression = bm_regression::compareToBaseline(results,
+                                        programSettings->dataSize, baseline,
+                                        programSettings->maxGuopsDrop,
+                                        programSettings->maxErrorIncrease);
+    }
+    bm_trace::write();
+
+    return regression ? 1 : 0;
+}
+
+/**
+The program entry point.
+Parses the settings and executes the benchmark. Errors of the benchmark
+runs are reported and end the program with exit code 1.
+*/
+int
+main(int argc, char * argv[]) {
+    // Setup benchmark
+    std::shared_ptr<ProgramSettings> programSettings =
+                                            parseProgramParameters(argc, argv);
+    try {
+        return runBenchmark(programSettings);
+    } catch (std::runtime_error const &error) {
+        std::cerr << error.what() << "! Aborting" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,195 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/multi_tenant.h"
+
+/* C++ standard library headers */
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/fpga_setup.h"
+#include "src/host/launch_engine.h"
+#include "src/host/placement.h"
+#include "src/host/random_access_definitions.h"
+#include "src/host/trace.h"
+#include "src/host/verification.h"
+
+namespace bm_execution {
+
+/*
+ @copydoc bm_execution::tenantOffset()
+*/
+DATA_TYPE_UNSIGNED
+tenantOffset(size_t tableSize, uint tenant) {
+    return 4L * tableSize * tenant;
+}
+
+/*
+ @copydoc bm_execution::calculateMultiTenant()
+*/
+std::shared_ptr<ExecutionResults>
+calculateMultiTenant(std::shared_ptr<ExecutionConfiguration> config) {
+    // int used to check for OpenCL errors
+    int err;
+    uint tenants = config->tenants;
+    size_t tableSize = config->dataSize / tenants;
+    // The tenant kernels calculate the uniform addresses without a table
+    if (!config->blockTable.empty()) {
+        throw std::runtime_error("The multi-tenant mode does not support "
+                                 "address distributions");
+    }
+
+    // The tables are placed like the chunks of the first replications
+    std::shared_ptr<ExecutionConfiguration> tenantConfig(
+                                    new ExecutionConfiguration(*config));
+    tenantConfig->replications = tenants;
+    tenantConfig->memoryBanks.resize(tenants);
+    std::vector<cl::Buffer> Buffer_data = createDataBuffers(tenantConfig,
+                                                            tableSize);
+
+    std::vector<DATA_TYPE_UNSIGNED*> tables;
+    std::vector<cl::CommandQueue> compute_queue;
+    std::vector<cl::Buffer> Buffer_checksum;
+    std::vector<cl::Kernel> tenantkernel;
+    for (uint t = 0; t < tenants; t++) {
+        TRACE_SCOPE("prepare tenant");
+        reportProgress(*config, "prepare", t, tenants);
+        DATA_TYPE_UNSIGNED* table;
+        posix_memalign(reinterpret_cast<void **>(&table), 64,
+                       ENTRY_SIZE * tableSize);
+        bm_verification::initializeData(table, tableSize, 0);
+        tables.push_back(table);
+
+        compute_queue.push_back(cl::CommandQueue(config->context,
+                                    config->device,
+                                    bm_trace::queueProperties()));
+        tenantkernel.push_back(cl::Kernel(config->program,
+                    (MULTI_TENANT_KERNEL_NAME + std::to_string(t)).c_str(),
+                    &err));
+        ASSERT_CL(err);
+        err = tenantkernel[t].setArg(0, Buffer_data[t]);
+        ASSERT_CL(err);
+        err = tenantkernel[t].setArg(1, DATA_TYPE_UNSIGNED(tableSize));
+        ASSERT_CL(err);
+        // Every tenant starts at its own offset of the update sequence
+        err = tenantkernel[t].setArg(2,
+                DATA_TYPE_UNSIGNED(starts(tenantOffset(tableSize, t))));
+        ASSERT_CL(err);
+        if (config->operation == OPERATION_GATHER) {
+            std::vector<DATA_TYPE_UNSIGNED> zeros(ENTRY_WIDTH, 0);
+            Buffer_checksum.push_back(cl::Buffer(config->context,
+                        CL_MEM_WRITE_ONLY, ENTRY_SIZE));
+            compute_queue[t].enqueueWriteBuffer(Buffer_checksum[t],
+                        CL_TRUE, 0, ENTRY_SIZE, zeros.data());
+            err = tenantkernel[t].setArg(3, Buffer_checksum[t]);
+            ASSERT_CL(err);
+        }
+    }
+    reportProgress(*config, "prepare", tenants, tenants);
+
+    // Executes the kernels of all tenants together once and measures the
+    // time of every tenant. The host tables keep the initial data until
+    // they are read back, so every execution starts from the initial data.
+    LaunchEngine launchEngine(compute_queue, tenantkernel, 0,
+                              config->serialLaunch);
+    std::vector<double> tenantTimes;
+    auto execute = [&]() {
+        for (uint t = 0; t < tenants; t++) {
+            compute_queue[t].enqueueWriteBuffer(Buffer_data[t], CL_TRUE, 0,
+                                            ENTRY_SIZE * tableSize, tables[t]);
+        }
+        double enqueueTime = bm_trace::now();
+        LaunchTimes launchTimes = launchEngine.execute();
+        bm_trace::addEvent("kernel execution", enqueueTime,
+                           bm_trace::now() - enqueueTime, TRACE_HOST_TID);
+        for (uint t = 0; t < tenants; t++) {
+            bm_trace::addCLEvent("tenant " + std::to_string(t),
+                                 launchEngine.events()[t], t, enqueueTime);
+        }
+        tenantTimes = launchTimes.finishTimes;
+        return launchTimes.span;
+    };
+
+    std::shared_ptr<TenantResults> tenantResults(new TenantResults {
+                            tableSize,
+                            std::vector<std::vector<double>>(tenants), {}});
+    std::vector<double> times;
+    uint total = config->warmupRepetitions + config->repetitions;
+    for (uint i = 0; i < total; i++) {
+        double totalTime = execute();
+        if (i >= config->warmupRepetitions) {
+            times.push_back(totalTime);
+            for (uint t = 0; t < tenants; t++) {
+                tenantResults->times[t].push_back(tenantTimes[t]);
+            }
+        }
+        reportProgress(*config, "execute", i + 1, total);
+    }
+
+    /* --- Check Results --- */
+
+    reportProgress(*config, "verify", 0, tenants);
+    size_t errors = 0;
+    for (uint t = 0; t < tenants; t++) {
+        compute_queue[t].enqueueReadBuffer(Buffer_data[t], CL_TRUE, 0,
+                                           ENTRY_SIZE * tableSize, tables[t]);
+        DATA_TYPE_UNSIGNED const first = tenantOffset(tableSize, t);
+        size_t tenantErrors = bm_verification::verifyTenantData(tables[t],
+                                        tableSize, config->operation, 1,
+                                        first);
+        if (config->operation == OPERATION_GATHER) {
+            std::vector<DATA_TYPE_UNSIGNED> partial(ENTRY_WIDTH);
+            compute_queue[t].enqueueReadBuffer(Buffer_checksum[t], CL_TRUE,
+                                               0, ENTRY_SIZE, partial.data());
+            DATA_TYPE_UNSIGNED checksum = 0;
+            for (DATA_TYPE_UNSIGNED value : partial) {
+                checksum ^= value;
+            }
+            if (checksum != bm_verification::calculateTenantChecksum(
+                                                        tableSize, first)) {
+                tenantErrors += tableSize;
+            }
+        }
+        tenantResults->errorRates.push_back(
+                            static_cast<double>(tenantErrors) / tableSize);
+        errors += tenantErrors;
+        free(reinterpret_cast<void *>(tables[t]));
+        reportProgress(*config, "verify", t + 1, tenants);
+    }
+
+    std::shared_ptr<ExecutionResults> results(
+        new ExecutionResults {times,
+                              static_cast<double>(errors) / config->dataSize,
+                              nullptr, nullptr, nullptr, tenantResults});
+    results->launch = launchEngine.summary(config->warmupRepetitions);
+    return results;
+}
+
+}  // namespace bm_execution
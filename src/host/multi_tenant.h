@@ -0,0 +1,69 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_MULTI_TENANT_H_
+#define SRC_HOST_MULTI_TENANT_H_
+
+/* C++ standard library headers */
+#include <memory>
+
+/* Project's headers */
+#include "src/host/execution.h"
+#include "src/host/random_access_definitions.h"
+
+namespace bm_execution {
+
+/**
+Calculates the position in the update sequence where the updates of a
+tenant start. The tenants continue the sequence one after another, so
+together they apply the updates of a single table of the whole size.
+
+@param tableSize Number of entries in the table of every tenant
+@param tenant The index of the tenant
+
+@return Number of updates of the sequence before the first update of the
+        tenant
+*/
+DATA_TYPE_UNSIGNED
+tenantOffset(size_t tableSize, uint tenant);
+
+/**
+Executes the benchmark for multiple tenants that share the device. The
+kernels have to be synthesized with MULTI_TENANT_KERNEL defined.
+Every tenant owns an independent table of config->dataSize /
+config->tenants entries in the memory bank of the replication with the same
+index and its own command queue. The kernels of all tenants are started
+together and every tenant is verified on its own. The time of an execution
+is the time until the last tenant finished.
+
+@param config The configuration of the benchmark run. tenants is used in
+        addition to the settings used by calculate().
+
+@return The time measurements without warm-up and the error rate counted from
+        the executions. The times and error rates of the tenants are
+        contained in the tenant results.
+*/
+std::shared_ptr<ExecutionResults>
+calculateMultiTenant(std::shared_ptr<ExecutionConfiguration> config);
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_MULTI_TENANT_H_
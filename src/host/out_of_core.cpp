@@ -0,0 +1,274 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/out_of_core.h"
+
+/* C++ standard library headers */
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* Project's headers */
+#include "src/host/fpga_setup.h"
+#include "src/host/placement.h"
+#include "src/host/random_access_definitions.h"
+#include "src/host/repetition_control.h"
+#include "src/host/trace.h"
+#include "src/host/verification.h"
+
+/**
+Number of buffer sets that are used alternately for the windows
+*/
+#define OUT_OF_CORE_BUFFER_SETS 2
+
+namespace bm_execution {
+
+/*
+Allocates the data array in host memory or maps it from the given file.
+Throws std::runtime_error if the memory or the file can not be used.
+
+@return the allocated data array
+*/
+static DATA_TYPE_UNSIGNED*
+allocateTable(std::string const &fileName, size_t dataSize) {
+    size_t tableBytes = ENTRY_SIZE * dataSize;
+    if (fileName.empty()) {
+        DATA_TYPE_UNSIGNED* data;
+        if (posix_memalign(reinterpret_cast<void **>(&data), 64,
+                           tableBytes) != 0) {
+            throw std::runtime_error("Could not allocate "
+                                     + std::to_string(tableBytes)
+                                     + " Byte for the data array");
+        }
+        return data;
+    }
+    int fd = open(fileName.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0 || ftruncate(fd, tableBytes) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw std::runtime_error("Could not create table file " + fileName);
+    }
+    void* data = mmap(NULL, tableBytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Could not map table file " + fileName);
+    }
+    return reinterpret_cast<DATA_TYPE_UNSIGNED*>(data);
+}
+
+/*
+Frees the data array allocated by allocateTable()
+*/
+static void
+freeTable(DATA_TYPE_UNSIGNED* data, std::string const &fileName,
+          size_t dataSize) {
+    if (fileName.empty()) {
+        free(reinterpret_cast<void *>(data));
+    } else {
+        munmap(data, ENTRY_SIZE * dataSize);
+    }
+}
+
+/*
+Sends a block of updates to the device and applies them to the window.
+The write is blocking, so the block can be cleared and reused afterwards.
+*/
+static void
+sendBlock(cl::CommandQueue const &queue, cl::Buffer const &buffer,
+          cl::Kernel &kernel, std::vector<DATA_TYPE_UNSIGNED>* block) {
+    queue.enqueueWriteBuffer(buffer, CL_TRUE, 0,
+                             sizeof(DATA_TYPE_UNSIGNED) * block->size(),
+                             block->data());
+    int err = kernel.setArg(2, DATA_TYPE_UNSIGNED(block->size()));
+    ASSERT_CL(err);
+    queue.enqueueTask(kernel);
+    block->clear();
+}
+
+/*
+ @copydoc bm_execution::calculateOutOfCore()
+*/
+std::shared_ptr<ExecutionResults>
+calculateOutOfCore(std::shared_ptr<ExecutionConfiguration> config) {
+    int err;
+    uint replications = config->replications;
+    size_t dataSize = config->dataSize;
+    size_t windowSize = config->windowSize;
+    size_t chunkSize = windowSize / replications;
+
+    if (config->operation == OPERATION_GATHER) {
+        throw std::runtime_error("The out-of-core mode does not support "
+                                 "gather");
+    }
+    // The updates are filtered on the host with their uniform addresses
+    if (!config->blockTable.empty()) {
+        throw std::runtime_error("The out-of-core mode does not support "
+                                 "address distributions");
+    }
+    if (windowSize > dataSize || dataSize % windowSize != 0
+            || windowSize % replications != 0) {
+        throw std::runtime_error("The data size has to be a multiple of the "
+                                 "window size and the window size a multiple "
+                                 "of the replications");
+    }
+    size_t windows = dataSize / windowSize;
+
+    /* --- Prepare kernels --- */
+
+    std::vector<std::vector<cl::CommandQueue>> queues(OUT_OF_CORE_BUFFER_SETS);
+    std::vector<std::vector<cl::Buffer>> windowBuffers;
+    std::vector<std::vector<cl::Buffer>> updateBuffers(OUT_OF_CORE_BUFFER_SETS);
+    std::vector<std::vector<cl::Kernel>> kernels(OUT_OF_CORE_BUFFER_SETS);
+    for (int s=0; s < OUT_OF_CORE_BUFFER_SETS; s++) {
+        TRACE_SCOPE("prepare buffer set");
+        // Every buffer set needs its own buffers, so the shared buffers of
+        // the configuration can not be used
+        windowBuffers.push_back(allocateDataBuffers(config, chunkSize));
+        for (int r=0; r < replications; r++) {
+            queues[s].push_back(cl::CommandQueue(config->context,
+                                            config->device,
+                                            bm_trace::queueProperties()));
+            updateBuffers[s].push_back(cl::Buffer(config->context,
+                    memoryBankFlag(config->memoryBanks[r]) | CL_MEM_READ_ONLY,
+                    sizeof(DATA_TYPE_UNSIGNED) * OUT_OF_CORE_BLOCK_SIZE));
+            kernels[s].push_back(cl::Kernel(config->program,
+                    (OUT_OF_CORE_KERNEL_NAME + std::to_string(r)).c_str(),
+                    &err));
+            ASSERT_CL(err);
+            err = kernels[s][r].setArg(0, windowBuffers[s][r]);
+            ASSERT_CL(err);
+            err = kernels[s][r].setArg(1, updateBuffers[s][r]);
+            ASSERT_CL(err);
+            err = kernels[s][r].setArg(3, DATA_TYPE_UNSIGNED(dataSize));
+            ASSERT_CL(err);
+        }
+    }
+
+    DATA_TYPE_UNSIGNED* data = allocateTable(config->tableFileName, dataSize);
+    std::vector<std::vector<DATA_TYPE_UNSIGNED>> blocks(replications);
+    for (auto &block : blocks) {
+        block.reserve(OUT_OF_CORE_BLOCK_SIZE);
+    }
+
+    /* --- Execute actual benchmark kernels --- */
+
+    RepetitionControl repetitionControl(config, 4.0 * dataSize);
+    while (repetitionControl.next()) {
+        // The table is in host memory, so it is initialized on the host
+        // before every execution, also in a soak run
+        bm_verification::initializeData(data, dataSize, 0);
+
+        double passesStart = bm_trace::now();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (size_t w=0; w < windows; w++) {
+            TRACE_SCOPE("out-of-core pass");
+            int s = w % OUT_OF_CORE_BUFFER_SETS;
+            size_t windowStart = w * windowSize;
+
+            // Send the window to the device after the buffer set is free
+            for (int r=0; r < replications; r++) {
+                queues[s][r].finish();
+                queues[s][r].enqueueWriteBuffer(windowBuffers[s][r],
+                        CL_FALSE, 0, ENTRY_SIZE * chunkSize,
+                        data + (windowStart + r * chunkSize) * ENTRY_WIDTH);
+                err = kernels[s][r].setArg(4, DATA_TYPE_UNSIGNED(
+                                               windowStart + r * chunkSize));
+                ASSERT_CL(err);
+            }
+
+            // Filter the updates of the window and stream them in blocks
+            DATA_TYPE_UNSIGNED ran = 1;
+            for (DATA_TYPE_UNSIGNED i=0; i < 4 * dataSize; i++) {
+                DATA_TYPE v = 0;
+                if (((DATA_TYPE) ran) < 0) {
+                    v = POLY;
+                }
+                ran = (ran << 1) ^ v;
+                DATA_TYPE_UNSIGNED address = (ran & (dataSize - 1))
+                                                - windowStart;
+                if (address < windowSize) {
+                    int r = address / chunkSize;
+                    blocks[r].push_back(ran);
+                    if (blocks[r].size() == OUT_OF_CORE_BLOCK_SIZE) {
+                        sendBlock(queues[s][r], updateBuffers[s][r],
+                                  kernels[s][r], &blocks[r]);
+                    }
+                }
+            }
+            for (int r=0; r < replications; r++) {
+                if (!blocks[r].empty()) {
+                    sendBlock(queues[s][r], updateBuffers[s][r],
+                              kernels[s][r], &blocks[r]);
+                }
+            }
+
+            // Send the updated window back to the host
+            for (int r=0; r < replications; r++) {
+                queues[s][r].enqueueReadBuffer(windowBuffers[s][r],
+                        CL_FALSE, 0, ENTRY_SIZE * chunkSize,
+                        data + (windowStart + r * chunkSize) * ENTRY_WIDTH);
+                queues[s][r].flush();
+            }
+        }
+        for (int s=0; s < OUT_OF_CORE_BUFFER_SETS; s++) {
+            for (int r=0; r < replications; r++) {
+                queues[s][r].finish();
+            }
+        }
+        auto t2 = std::chrono::high_resolution_clock::now();
+        bm_trace::addEvent("out-of-core execution", passesStart,
+                           bm_trace::now() - passesStart, TRACE_HOST_TID);
+        std::chrono::duration<double> timespan =
+            std::chrono::duration_cast<std::chrono::duration<double>>
+                                                                (t2 - t1);
+        repetitionControl.addExecution(timespan.count());
+    }
+    repetitionControl.finish();
+
+    /* --- Check Results --- */
+
+    reportProgress(*config, "verify", 0, 1);
+    size_t errors = bm_verification::verifyData(data, dataSize,
+                    config->blockTable, config->operation, 1, nullptr);
+    freeTable(data, config->tableFileName, dataSize);
+
+    std::shared_ptr<ExecutionResults> results(
+                    new ExecutionResults{repetitionControl.getTimes(),
+                                         static_cast<double>(errors)
+                                                            / dataSize,
+                                         nullptr, nullptr});
+    return results;
+}
+
+}  // namespace bm_execution
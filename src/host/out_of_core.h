@@ -0,0 +1,66 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_OUT_OF_CORE_H_
+#define SRC_HOST_OUT_OF_CORE_H_
+
+/* C++ standard library headers */
+#include <memory>
+
+/* Project's headers */
+#include "src/host/execution.h"
+
+/**
+Maximum number of updates that are sent to the device in a single block
+for every replication
+*/
+#ifndef OUT_OF_CORE_BLOCK_SIZE
+#define OUT_OF_CORE_BLOCK_SIZE 1048576
+#endif
+
+namespace bm_execution {
+
+/**
+Executes the benchmark for a data array that is kept in host memory and may
+be larger than the device memory. The kernels have to be synthesized with
+OUT_OF_CORE_KERNEL defined.
+The data array is processed in passes over windows of config->windowSize
+items. For every window, the host filters the updates that address the window
+and streams them to the device in blocks. The window is transferred to the
+device before and back to the host after its updates.
+Two sets of device buffers and command queues are used alternately, so the
+transfers and the filtering of a window overlap with the updates of the
+previous window.
+The measured times contain the transfers and the filtering on the host.
+
+@param config The configuration of the benchmark run. windowSize and
+        tableFileName are used in addition to the settings used by
+        calculate().
+
+@return The time measurements without warm-up and the error rate counted from
+        the executions
+*/
+std::shared_ptr<ExecutionResults>
+calculateOutOfCore(std::shared_ptr<ExecutionConfiguration> config);
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_OUT_OF_CORE_H_
@@ -0,0 +1,365 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/perf_counters.h"
+
+/* C++ standard library headers */
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#ifdef __linux__
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bm_perf {
+
+static thread_local bool enabled = false;
+static thread_local std::vector<PhaseCounters> threadPhases;
+
+/*
+Names of the counters in the order of their indices
+*/
+static char const* counterNames[] = {"cycles", "instructions",
+                                     "LLC-load-misses", "dTLB-load-misses",
+                                     "memory bytes"};
+
+#ifdef __linux__
+/*
+Opens a counter with the given attributes and returns its file descriptor or
+-1 if it is not available
+*/
+static int
+openCounter(perf_event_attr &attr, pid_t pid, int cpu) {
+    attr.size = sizeof(attr);
+    // Scale the values if the counters are multiplexed
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+                        | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, pid, cpu,
+                                    -1, 0));
+}
+
+/*
+Opens a counter for the user space of the calling thread and all threads
+it starts
+*/
+static int
+openThreadCounter(uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = type;
+    attr.config = config;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return openCounter(attr, 0, -1);
+}
+
+/*
+Returns the config of the read misses of the given cache
+*/
+static uint64_t
+cacheMisses(uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                 | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+/*
+Reads the first line of a file, e.g. from sysfs
+*/
+static std::string
+readLine(std::string const &fileName) {
+    std::ifstream file(fileName);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+/*
+Converts an event of a PMU in sysfs like "event=0x04,umask=0x03" to its
+config. The bits of every field are given in the format directory of the
+PMU like "config:8-15".
+*/
+static bool
+parseEvent(std::string const &device, std::string const &event,
+           uint64_t &config) {
+    std::string const base = "/sys/bus/event_source/devices/" + device;
+    std::string description = readLine(base + "/events/" + event);
+    if (description.empty()) {
+        return false;
+    }
+    config = 0;
+    std::stringstream terms(description);
+    std::string term;
+    while (std::getline(terms, term, ',')) {
+        size_t equals = term.find('=');
+        uint64_t value = (equals == std::string::npos) ? 1
+                    : strtoull(term.substr(equals + 1).c_str(), nullptr, 0);
+        std::string format = readLine(base + "/format/"
+                                      + term.substr(0, equals));
+        int low;
+        int high;
+        if (sscanf(format.c_str(), "config:%d-%d", &low, &high) != 2) {
+            if (sscanf(format.c_str(), "config:%d", &low) != 1) {
+                return false;
+            }
+            high = low;
+        }
+        uint64_t mask = (high - low >= 63) ? ~0ULL
+                                        : (1ULL << (high - low + 1)) - 1;
+        config |= (value & mask) << low;
+    }
+    return true;
+}
+
+/*
+Opens the read and write counters of all memory controllers of the system.
+Every controller is counted on the first CPU of its cpumask.
+*/
+static std::vector<int>
+openMemoryCounters() {
+    std::vector<int> files;
+    DIR* devices = opendir("/sys/bus/event_source/devices");
+    if (devices == nullptr) {
+        return files;
+    }
+    while (dirent* entry = readdir(devices)) {
+        std::string device = entry->d_name;
+        if (device.compare(0, 10, "uncore_imc") != 0) {
+            continue;
+        }
+        std::string const base = "/sys/bus/event_source/devices/" + device;
+        int type = atoi(readLine(base + "/type").c_str());
+        int cpu = atoi(readLine(base + "/cpumask").c_str());
+        for (char const* event : {"cas_count_read", "cas_count_write"}) {
+            uint64_t config;
+            if (!parseEvent(device, event, config)) {
+                continue;
+            }
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.type = type;
+            attr.config = config;
+            int file = openCounter(attr, -1, cpu);
+            if (file >= 0) {
+                files.push_back(file);
+            }
+        }
+    }
+    closedir(devices);
+    return files;
+}
+
+/*
+Reads a counter and scales its value to the whole time it was enabled
+*/
+static int64_t
+readCounter(int file) {
+    uint64_t data[3];
+    if (read(file, data, sizeof(data)) != sizeof(data)) {
+        return -1;
+    }
+    if (data[2] == 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(static_cast<double>(data[0]) * data[1]
+                                / data[2]);
+}
+#endif
+
+/*
+Prints a warning if the counters can not be opened
+*/
+static void
+checkAvailability() {
+#ifdef __linux__
+    int file = openThreadCounter(PERF_TYPE_HARDWARE,
+                                 PERF_COUNT_HW_CPU_CYCLES);
+    if (file >= 0) {
+        close(file);
+        return;
+    }
+    std::cerr << "Hardware performance counters are not available: "
+              << strerror(errno) << std::endl;
+#else
+    std::cerr << "Hardware performance counters are only available on Linux"
+              << std::endl;
+#endif
+}
+
+/*
+ @copydoc bm_perf::isEnabled()
+*/
+bool
+isEnabled() {
+    return enabled;
+}
+
+/*
+ @copydoc bm_perf::counterName()
+*/
+std::string
+counterName(int counter) {
+    return counterNames[counter];
+}
+
+/*
+ @copydoc bm_perf::resetPhases()
+*/
+void
+resetPhases() {
+    threadPhases.clear();
+}
+
+/*
+ @copydoc bm_perf::phases()
+*/
+std::vector<PhaseCounters>
+phases() {
+    return threadPhases;
+}
+
+/*
+ @copydoc bm_perf::toJSON()
+*/
+std::string
+toJSON(std::vector<int64_t> const &values) {
+    std::stringstream json;
+    for (size_t c = 0; c < values.size(); c++) {
+        if (values[c] < 0) {
+            continue;
+        }
+        if (json.tellp() > 0) {
+            json << ",";
+        }
+        json << "\"" << counterNames[c] << "\":" << values[c];
+    }
+    return json.str();
+}
+
+ScopedEnable::ScopedEnable(bool enable)
+        : previous(enabled) {
+    static std::once_flag checked;
+    if (enable) {
+        std::call_once(checked, checkAvailability);
+    }
+    enabled = enable;
+}
+
+ScopedEnable::~ScopedEnable() {
+    enabled = previous;
+}
+
+ScopedCounters::ScopedCounters(char const *name)
+        : name(name), running(enabled) {
+    if (!running) {
+        return;
+    }
+    files.resize(PERF_COUNTERS);
+#ifdef __linux__
+    int const types[] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                         PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE};
+    uint64_t const configs[] = {PERF_COUNT_HW_CPU_CYCLES,
+                                PERF_COUNT_HW_INSTRUCTIONS,
+                                cacheMisses(PERF_COUNT_HW_CACHE_LL),
+                                cacheMisses(PERF_COUNT_HW_CACHE_DTLB)};
+    for (int c = 0; c < PERF_MEMORY_BYTES; c++) {
+        int file = openThreadCounter(types[c], configs[c]);
+        if (file >= 0) {
+            files[c].push_back(file);
+        }
+    }
+    files[PERF_MEMORY_BYTES] = openMemoryCounters();
+#endif
+    start = std::chrono::high_resolution_clock::now();
+}
+
+ScopedCounters::~ScopedCounters() {
+    stop();
+}
+
+/*
+ @copydoc bm_perf::ScopedCounters::stop()
+*/
+std::vector<int64_t>
+ScopedCounters::stop() {
+    if (!running) {
+        return std::vector<int64_t>();
+    }
+    running = false;
+    double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(
+                std::chrono::high_resolution_clock::now() - start).count();
+    std::vector<int64_t> values(PERF_COUNTERS, -1);
+#ifdef __linux__
+    for (int c = 0; c < PERF_COUNTERS; c++) {
+        if (files[c].empty()) {
+            continue;
+        }
+        int64_t sum = 0;
+        for (int file : files[c]) {
+            int64_t value = readCounter(file);
+            sum = (value < 0 || sum < 0) ? -1 : sum + value;
+            close(file);
+        }
+        values[c] = sum;
+    }
+    // Every access of the memory controllers transfers a cache line
+    if (values[PERF_MEMORY_BYTES] > 0) {
+        values[PERF_MEMORY_BYTES] *= 64;
+    }
+#endif
+
+    PhaseCounters* phase = nullptr;
+    for (PhaseCounters &p : threadPhases) {
+        if (p.name == name) {
+            phase = &p;
+        }
+    }
+    if (phase == nullptr) {
+        threadPhases.push_back(PhaseCounters {name, 0, 0,
+                                    std::vector<int64_t>(PERF_COUNTERS, 0)});
+        phase = &threadPhases.back();
+    }
+    phase->calls++;
+    phase->seconds += seconds;
+    for (int c = 0; c < PERF_COUNTERS; c++) {
+        phase->values[c] = (values[c] < 0 || phase->values[c] < 0)
+                            ? -1 : phase->values[c] + values[c];
+    }
+    return values;
+}
+
+}  // namespace bm_perf
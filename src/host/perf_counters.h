@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_PERF_COUNTERS_H_
+#define SRC_HOST_PERF_COUNTERS_H_
+
+/* C++ standard library headers */
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+Indices of the hardware counters that are measured for every host phase
+*/
+#define PERF_CYCLES 0
+#define PERF_INSTRUCTIONS 1
+#define PERF_LLC_LOAD_MISSES 2
+#define PERF_DTLB_LOAD_MISSES 3
+#define PERF_MEMORY_BYTES 4
+#define PERF_COUNTERS 5
+
+/**
+Measures hardware performance counters of the host phases with
+perf_event_open. The cycles, instructions, LLC load misses and dTLB load
+misses are counted for the thread that executes a phase and all threads it
+starts. The transferred bytes of the memory controllers are counted for the
+whole system if uncore counters of the memory controllers exist.
+Counters that can not be opened, e.g. because perf is not available or not
+permitted, are reported as unavailable. The counters are enabled per thread
+and as long as they are not enabled, all calls return immediately.
+The phases are also kept per thread. Only phases that are started on the
+thread that collects them are part of its results. Threads that are started
+within a phase are still counted by it, but phases started on these threads
+are not collected.
+*/
+namespace bm_perf {
+
+/**
+Counter values of a host phase accumulated over all its executions.
+Unavailable counters have the value -1.
+*/
+struct PhaseCounters {
+    std::string name;
+    size_t calls;
+    double seconds;
+    std::vector<int64_t> values;
+};
+
+/**
+@return true, if the counters are enabled for the calling thread
+*/
+bool
+isEnabled();
+
+/**
+@param counter The index of the counter, e.g. PERF_CYCLES
+
+@return the name of the counter
+*/
+std::string
+counterName(int counter);
+
+/**
+Clears the phases recorded by the calling thread
+*/
+void
+resetPhases();
+
+/**
+Phases that were recorded by other threads, e.g. by the worker threads of a
+phase, are not contained.
+
+@return the phases recorded by the calling thread in the order of their first
+        execution
+*/
+std::vector<PhaseCounters>
+phases();
+
+/**
+Formats the values of the counters as arguments of a trace event
+
+@param values The values of all counters
+
+@return The members of a JSON object with the available counters
+*/
+std::string
+toJSON(std::vector<int64_t> const &values);
+
+/**
+Enables or disables the counters for the calling thread until it is
+destroyed. A warning is printed once if the counters are enabled but not
+available.
+*/
+class ScopedEnable {
+ public:
+    explicit ScopedEnable(bool enable);
+    ~ScopedEnable();
+
+ private:
+    bool previous;
+};
+
+/**
+Opens the counters on construction and adds their values to the phase with
+the given name of the calling thread when it is stopped or destroyed.
+*/
+class ScopedCounters {
+ public:
+    explicit ScopedCounters(char const *name);
+    ~ScopedCounters();
+
+    /**
+    Reads and closes the counters and adds them to the phase
+
+    @return The values of all counters. Empty if the counters are not
+            enabled or were already stopped.
+    */
+    std::vector<int64_t>
+    stop();
+
+ private:
+    char const *name;
+    std::chrono::high_resolution_clock::time_point start;
+    std::vector<std::vector<int>> files;
+    bool running;
+};
+
+}  // namespace bm_perf
+
+#endif  // SRC_HOST_PERF_COUNTERS_H_
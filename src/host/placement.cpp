@@ -0,0 +1,247 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/placement.h"
+
+/* C++ standard library headers */
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+#if QUARTUS_MAJOR_VERSION > 18
+#include "CL/cl_ext_intelfpga.h"
+#endif
+
+/* Project's headers */
+#include "src/host/fpga_setup.h"
+#include "src/host/random_access_definitions.h"
+#include "src/host/trace.h"
+
+namespace bm_execution {
+
+/*
+ @copydoc bm_execution::memoryBankFlag()
+*/
+cl_mem_flags
+memoryBankFlag(int bank) {
+    switch (bank) {
+        case INTERLEAVED_BANK: return 0;
+        case 1: return CL_CHANNEL_1_INTELFPGA;
+        case 2: return CL_CHANNEL_2_INTELFPGA;
+        case 3: return CL_CHANNEL_3_INTELFPGA;
+        case 4: return CL_CHANNEL_4_INTELFPGA;
+        case 5: return CL_CHANNEL_5_INTELFPGA;
+        case 6: return CL_CHANNEL_6_INTELFPGA;
+        case 7: return CL_CHANNEL_7_INTELFPGA;
+    }
+    throw std::runtime_error("Memory bank " + std::to_string(bank)
+                             + " can not be selected. Only banks up to "
+                             + std::to_string(MAX_CHANNEL_BANK)
+                             + " are supported");
+}
+
+/*
+ @copydoc bm_execution::assignMemoryBanks()
+*/
+std::vector<int>
+assignMemoryBanks(std::string const &policy, uint replications,
+                  uint numBanks) {
+    std::vector<int> banks;
+    if (policy == "interleaved" || policy == "sub-buffers") {
+        banks.resize(replications, INTERLEAVED_BANK);
+    } else if (policy == "round-robin") {
+        if (numBanks == 0) {
+            numBanks = replications;
+        }
+        for (uint r = 0; r < replications; r++) {
+            banks.push_back((r % numBanks) + 1);
+        }
+    } else {
+        // Parse the explicit list of banks
+        std::stringstream list(policy);
+        std::string bank;
+        while (std::getline(list, bank, ',')) {
+            char* end;
+            long value = strtol(bank.c_str(), &end, 10);
+            if (bank.empty() || *end != '\0' || value < 0) {
+                throw std::runtime_error("Unknown placement " + policy);
+            }
+            banks.push_back(static_cast<int>(value));
+        }
+        if (banks.size() != replications) {
+            throw std::runtime_error("The placement lists "
+                                     + std::to_string(banks.size())
+                                     + " banks but "
+                                     + std::to_string(replications)
+                                     + " replications are used");
+        }
+    }
+    // Check all banks before the benchmark starts
+    for (int bank : banks) {
+        memoryBankFlag(bank);
+    }
+    return banks;
+}
+
+/*
+ @copydoc bm_execution::describePlacement()
+*/
+std::string
+describePlacement(std::vector<int> const &banks, bool useSubBuffers) {
+    std::stringstream description;
+    if (useSubBuffers) {
+        description << "sub-buffers of one interleaved buffer";
+        return description.str();
+    }
+    description << "banks";
+    for (int bank : banks) {
+        if (bank == INTERLEAVED_BANK) {
+            description << " i";
+        } else {
+            description << " " << bank;
+        }
+    }
+    return description.str();
+}
+
+/*
+ @copydoc bm_execution::allocateDataBuffers()
+*/
+std::vector<cl::Buffer>
+allocateDataBuffers(std::shared_ptr<ExecutionConfiguration> config,
+                    size_t chunkSize) {
+    int err;
+    size_t chunkBytes = ENTRY_SIZE * chunkSize;
+    std::vector<cl::Buffer> buffers;
+    if (!config->useSubBuffers) {
+        for (int bank : config->memoryBanks) {
+            buffers.push_back(cl::Buffer(config->context,
+                        memoryBankFlag(bank) | CL_MEM_READ_WRITE, chunkBytes,
+                        NULL, &err));
+            ASSERT_CL(err);
+        }
+        return buffers;
+    }
+
+    // The origin of every sub-buffer has to be aligned to the base address
+    // alignment of the device given in bits
+    size_t alignment =
+            config->device.getInfo<CL_DEVICE_MEM_BASE_ADDR_ALIGN>() / 8;
+    if (alignment > 0 && chunkBytes % alignment != 0) {
+        throw std::runtime_error("Size of a replication ("
+                                 + std::to_string(chunkBytes)
+                                 + " Byte) is not aligned to "
+                                 + std::to_string(alignment)
+                                 + " Byte. Sub-buffers can not be used");
+    }
+    // The sub-buffers keep the parent buffer alive
+    cl::Buffer parent(config->context, CL_MEM_READ_WRITE,
+                      chunkBytes * config->replications, NULL, &err);
+    ASSERT_CL(err);
+    for (uint r = 0; r < config->replications; r++) {
+        cl_buffer_region region = {r * chunkBytes, chunkBytes};
+        buffers.push_back(parent.createSubBuffer(CL_MEM_READ_WRITE,
+                        CL_BUFFER_CREATE_TYPE_REGION, &region, &err));
+        ASSERT_CL(err);
+    }
+    return buffers;
+}
+
+/*
+ @copydoc bm_execution::createDataBuffers()
+*/
+std::vector<cl::Buffer>
+createDataBuffers(std::shared_ptr<ExecutionConfiguration> config,
+                  size_t chunkSize) {
+    std::shared_ptr<SharedBuffers> shared = config->sharedBuffers;
+    if (!shared) {
+        return allocateDataBuffers(config, chunkSize);
+    }
+    if (shared->buffers.empty() || shared->chunkSize != chunkSize
+            || shared->memoryBanks != config->memoryBanks
+            || shared->useSubBuffers != config->useSubBuffers) {
+        // Release the old buffers before the new ones are allocated
+        shared->buffers.clear();
+        shared->buffers = allocateDataBuffers(config, chunkSize);
+        shared->memoryBanks = config->memoryBanks;
+        shared->useSubBuffers = config->useSubBuffers;
+        shared->chunkSize = chunkSize;
+    }
+    return shared->buffers;
+}
+
+/*
+ @copydoc bm_execution::copyDataBuffers()
+*/
+std::vector<cl::Buffer>
+copyDataBuffers(std::shared_ptr<ExecutionConfiguration> config,
+                std::vector<cl::CommandQueue> &queues,
+                std::vector<cl::Buffer> &dataBuffers, size_t chunkSize) {
+    int err;
+    size_t chunkBytes = ENTRY_SIZE * chunkSize;
+    std::vector<cl::Buffer> copies;
+    for (uint r = 0; r < dataBuffers.size(); r++) {
+        int bank = config->useSubBuffers ? INTERLEAVED_BANK
+                                         : config->memoryBanks[r];
+        copies.push_back(cl::Buffer(config->context,
+                    memoryBankFlag(bank) | CL_MEM_READ_WRITE, chunkBytes,
+                    NULL, &err));
+        ASSERT_CL(err);
+        err = queues[r].enqueueCopyBuffer(dataBuffers[r], copies[r], 0, 0,
+                                          chunkBytes);
+        ASSERT_CL(err);
+    }
+    for (auto &queue : queues) {
+        queue.finish();
+    }
+    return copies;
+}
+
+/*
+ @copydoc bm_execution::restoreDataBuffers()
+*/
+void
+restoreDataBuffers(std::vector<cl::CommandQueue> &queues,
+                   std::vector<cl::Buffer> &copies,
+                   std::vector<cl::Buffer> &dataBuffers, size_t chunkSize) {
+    int err;
+    std::vector<cl::Event> copyEvents(copies.size());
+    double enqueueTime = bm_trace::now();
+    for (uint r = 0; r < copies.size(); r++) {
+        err = queues[r].enqueueCopyBuffer(copies[r], dataBuffers[r], 0, 0,
+                                          ENTRY_SIZE * chunkSize, NULL,
+                                          &copyEvents[r]);
+        ASSERT_CL(err);
+    }
+    for (uint r = 0; r < copies.size(); r++) {
+        queues[r].finish();
+        bm_trace::addCLEvent("restore data", copyEvents[r], r, enqueueTime);
+    }
+}
+
+}  // namespace bm_execution
@@ -0,0 +1,159 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_PLACEMENT_H_
+#define SRC_HOST_PLACEMENT_H_
+
+/* C++ standard library headers */
+#include <memory>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/execution.h"
+
+/**
+Bank index used for buffers that are not placed in a specific memory bank.
+Their data is interleaved over all banks.
+*/
+#define INTERLEAVED_BANK 0
+
+/**
+Highest memory bank that can be selected with the CL_CHANNEL_*_INTELFPGA
+flags when the buffer is created
+*/
+#define MAX_CHANNEL_BANK 7
+
+namespace bm_execution {
+
+/**
+Converts a memory bank to the flag used to create a buffer in this bank.
+Throws std::runtime_error if the bank can not be selected with a flag.
+
+@param bank The memory bank. INTERLEAVED_BANK for an interleaved buffer.
+
+@return The flag that has to be added to the flags of the buffer
+*/
+cl_mem_flags
+memoryBankFlag(int bank);
+
+/**
+Assigns a memory bank to every replication using the given placement policy.
+Throws std::runtime_error if the policy is unknown or the banks can not be
+selected.
+
+@param policy The placement policy. One of:
+        - interleaved: All buffers are interleaved over all banks
+        - round-robin: Replication r is placed in bank (r % numBanks) + 1
+        - sub-buffers: One interleaved buffer is split into sub-buffers
+        - a comma separated list of banks for every replication, e.g. 1,2,1,2.
+                Bank 0 stands for an interleaved buffer.
+@param replications Number of replications
+@param numBanks Number of banks used for round-robin. If 0, every replication
+                gets its own bank.
+
+@return The bank of every replication. INTERLEAVED_BANK for interleaved
+        buffers.
+*/
+std::vector<int>
+assignMemoryBanks(std::string const &policy, uint replications,
+                  uint numBanks);
+
+/**
+Creates a description of the placement that can be printed in the summary
+
+@param banks The bank of every replication
+@param useSubBuffers true, if the buffers are sub-buffers of a single buffer
+
+@return The description of the placement
+*/
+std::string
+describePlacement(std::vector<int> const &banks, bool useSubBuffers);
+
+/**
+Allocates new data buffers for all replications with the placement given in
+the configuration. Either every buffer is created in its assigned memory bank
+or a single interleaved buffer is created and split into sub-buffers.
+The shared buffers of the configuration are not used.
+
+@param config The configuration of the benchmark run
+@param chunkSize Number of entries in the buffer of a single replication
+
+@return The new data buffers of all replications
+*/
+std::vector<cl::Buffer>
+allocateDataBuffers(std::shared_ptr<ExecutionConfiguration> config,
+                    size_t chunkSize);
+
+/**
+Creates the data buffers of all replications with the placement given in the
+configuration. Either every buffer is created in its assigned memory bank or
+a single interleaved buffer is created and split into sub-buffers.
+If the configuration contains shared buffers, the buffers of the previous
+run are returned if they have the same size and placement.
+
+@param config The configuration of the benchmark run
+@param chunkSize Number of entries in the buffer of a single replication
+
+@return The data buffers of all replications
+*/
+std::vector<cl::Buffer>
+createDataBuffers(std::shared_ptr<ExecutionConfiguration> config,
+                  size_t chunkSize);
+
+/**
+Creates a copy of the initialized data buffers on the device. The copies are
+placed in the same memory banks as the data buffers and are used to restore
+the initial data without transferring it from the host again.
+The copies double the memory used for the data on the device.
+
+@param config The configuration of the benchmark run
+@param queues The queue of every replication
+@param dataBuffers The initialized data buffers of all replications
+@param chunkSize Number of entries in the buffer of a single replication
+@return The copies of the data buffers
+*/
+std::vector<cl::Buffer>
+copyDataBuffers(std::shared_ptr<ExecutionConfiguration> config,
+                std::vector<cl::CommandQueue> &queues,
+                std::vector<cl::Buffer> &dataBuffers, size_t chunkSize);
+
+/**
+Restores the initial data of all replications from the copies created with
+copyDataBuffers(). Returns after all copies are finished, so they are not
+included in the time of the next kernel execution.
+
+@param queues The queue of every replication
+@param copies The copies of the initialized data buffers
+@param dataBuffers The data buffers of all replications
+@param chunkSize Number of entries in the buffer of a single replication
+*/
+void
+restoreDataBuffers(std::vector<cl::CommandQueue> &queues,
+                   std::vector<cl::Buffer> &copies,
+                   std::vector<cl::Buffer> &dataBuffers, size_t chunkSize);
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_PLACEMENT_H_
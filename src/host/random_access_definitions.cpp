@@ -0,0 +1,119 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/random_access_definitions.h"
+
+/* C++ standard library headers */
+#include <string>
+
+/*
+Names of the operations in the order of their identifiers
+*/
+static const char* operationNames[] = {"xor", "add", "scatter", "gather",
+                                       "cas"};
+
+/*
+ @copydoc operationFromName()
+*/
+int
+operationFromName(std::string const &name) {
+    for (int i = 0; i <= OPERATION_CAS; i++) {
+        if (name == operationNames[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+ @copydoc operationName()
+*/
+std::string
+operationName(int operation) {
+    return operationNames[operation];
+}
+
+/**
+ Generates the value of the random number after a desired number of updates
+
+ @param n number of random number updates
+
+ @return The random number after n number of updates
+ */
+DATA_TYPE_UNSIGNED
+starts(DATA_TYPE n) {
+    DATA_TYPE_UNSIGNED m2[BIT_SIZE];
+
+    while (n < 0) {
+        n += PERIOD;
+    }
+    while (n > PERIOD) {
+        n -= PERIOD;
+    }
+
+    if (n == 0) {
+        return 1;
+    }
+
+    DATA_TYPE_UNSIGNED temp = 1;
+    for (int i=0; i < BIT_SIZE; i++) {
+        m2[i] = temp;
+        for (int j=0; j < 2; j++) {
+            DATA_TYPE v = 0;
+            if (((DATA_TYPE) temp) < 0) {
+                v = POLY;
+            }
+            temp = (temp << 1) ^ v;
+        }
+    }
+    // DATA_TYPE i = BIT_SIZE - 2;
+    // while (i >= 0 && !((n >> i) & 1)) {
+    //     i--;
+    // }
+    int i = 0;
+    for (i=BIT_SIZE - 2; i >= 0; i--) {
+        if ((n >> i) & 1) {
+            break;
+        }
+    }
+
+    DATA_TYPE_UNSIGNED ran = 2;
+    while (i > 0) {
+        temp = 0;
+        for (int j=0; j < BIT_SIZE; j++) {
+            if ((ran >> j) & 1) {
+                temp ^= m2[j];
+            }
+        }
+        ran = temp;
+        i--;
+        if ((n >> i) & 1) {
+            DATA_TYPE v = 0;
+            if (((DATA_TYPE) ran) < 0) {
+                v = POLY;
+            }
+            ran = (ran << 1) ^v;
+        }
+    }
+    return ran;
+}
@@ -0,0 +1,168 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef SRC_HOST_RANDOM_ACCESS_DEFINITIONS_H_
+#define SRC_HOST_RANDOM_ACCESS_DEFINITIONS_H_
+
+/* C++ standard library headers */
+#include <string>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/*
+Definitions of the data array, the kernels and the update operations that
+are used by the host code. They do not contain the command line interface,
+which is declared in random_access_functionality.h, so they can also be
+included by programs that use the host code as a library.
+*/
+
+/**
+Total length of the data array used for random accesses in words.
+The array should allocate half of the available global memory space.
+Keep in mind that this also depends on DATA_TYPE. The default number of
+entries is DATA_LENGTH / ENTRY_WIDTH.
+*/
+#ifndef DATA_LENGTH
+#define DATA_LENGTH 67108864
+#endif
+
+/**
+The data type used for the random accesses.
+Note that it should be big enough to address the whole data array. Moreover it
+has to be the same type as in the used kernels.
+The signed and unsigned form of the data type have to be given separately.
+*/
+#ifndef DATA_TYPE
+    #define DATA_TYPE cl_long
+#endif
+#ifndef DATA_TYPE_UNSIGNED
+#define DATA_TYPE_UNSIGNED cl_ulong
+#endif
+
+/**
+Number of words of DATA_TYPE_UNSIGNED in an entry of the data array.
+Every update loads and stores a whole entry and applies its random number to
+all words of the entry, so the entries can be sized like the records of an
+application or the burst of the memory. Word w of entry a is initialized
+with a * ENTRY_WIDTH + w. It has to be the same as in the used kernels.
+*/
+#ifndef ENTRY_WIDTH
+#define ENTRY_WIDTH 1
+#endif
+
+/**
+Size of an entry of the data array in bytes
+*/
+#define ENTRY_SIZE (sizeof(DATA_TYPE_UNSIGNED) * ENTRY_WIDTH)
+
+/**
+Prefix of the function name of the used kernel.
+It will be used to construct the full function name for the case of replications.
+The full name will be
+*/
+#define RANDOM_ACCESS_KERNEL "accessMemory"
+
+/**
+Prefix of the function name of the streaming kernel used to measure the
+sequential bandwidth baseline. The index of the replication is appended.
+*/
+#define BANDWIDTH_KERNEL_NAME "streamMemory"
+
+/**
+Prefix of the function name of the pointer chasing kernel used to measure the
+latency of dependent reads. The index of the replication is appended.
+*/
+#define LATENCY_KERNEL_NAME "chaseMemory"
+
+/**
+Prefix of the function name of the kernel used to apply the updates in the
+out-of-core mode. The index of the replication is appended.
+*/
+#define OUT_OF_CORE_KERNEL_NAME "applyUpdates"
+
+/**
+Prefix of the function name of the kernel used by a tenant in the
+multi-tenant mode. The index of the tenant is appended.
+*/
+#define MULTI_TENANT_KERNEL_NAME "tenantMemory"
+
+/**
+Constants used to verify benchmark results
+*/
+#define POLY 7
+#define PERIOD 1317624576693539401L
+
+#define BIT_SIZE (sizeof(DATA_TYPE) * 8)
+
+/**
+Operations that can be used by the kernels to update the data array.
+The kernels are synthesized for a single operation given by OPERATION.
+It is also used as default for the verification on the host.
+*/
+#define OPERATION_XOR 0
+#define OPERATION_ADD 1
+#define OPERATION_SCATTER 2
+#define OPERATION_GATHER 3
+#define OPERATION_CAS 4
+
+#ifndef OPERATION
+#define OPERATION OPERATION_XOR
+#endif
+
+/**
+Width of the columns of the printed results
+*/
+#define ENTRY_SPACE 13
+
+/**
+Converts the name of an operation to its identifier
+
+@param name The name of the operation, e.g. "xor"
+
+@return The identifier of the operation, e.g. OPERATION_XOR or -1 if the
+        name is unknown
+*/
+int
+operationFromName(std::string const &name);
+
+/**
+Converts the identifier of an operation to its name
+
+@param operation The identifier of the operation, e.g. OPERATION_XOR
+
+@return The name of the operation, e.g. "xor"
+*/
+std::string
+operationName(int operation);
+
+/**
+ Generates the value of the random number after a desired number of updates
+
+ @param n number of random number updates
+
+ @return The random number after n number of updates
+ */
+DATA_TYPE_UNSIGNED
+starts(DATA_TYPE n);
+
+#endif  // SRC_HOST_RANDOM_ACCESS_DEFINITIONS_H_
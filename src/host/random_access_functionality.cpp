@@ -24,11 +24,13 @@ SOFTWARE.
 #include "src/host/random_access_functionality.h"
 
 /* C++ standard library headers */
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <limits>
 #include <iomanip>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 /* External library headers */
@@ -39,8 +41,13 @@ SOFTWARE.
 #include "cxxopts.hpp"
 
 /* Project's headers */
+#include "src/host/address_distribution.h"
 #include "src/host/fpga_setup.h"
 #include "src/host/execution.h"
+#include "src/host/heatmap.h"
+#include "src/host/host_scaling.h"
+#include "src/host/regression_gate.h"
+#include "src/host/statistics.h"
 
 
 /**
@@ -48,9 +55,32 @@ Parses and returns program options using the cxxopts library.
 Supports the following parameters:
     - file name of the FPGA kernel file (-f,--file)
     - number of repetitions (-n)
+    - warm-up and adaptive repetitions (--warmup, --rse, --max-repetitions)
     - number of kernel replications (-r)
     - data size (-d)
     - use memory interleaving
+    - soak run duration, confidence and sample interval (--soak*)
+    - trace file (--trace)
+    - measure bandwidth baseline (--bandwidth)
+    - measure latency of dependent reads (--latency)
+    - update operation (--operation)
+    - placement of the data in the memory banks (--placement, --banks)
+    - out-of-core mode (--out-of-core, --table-file)
+    - kernel type of the bitstream (--type)
+    - comparison with a baseline (--compare, --compare-board,
+      --baseline-file, --max-drop, --max-error-increase)
+    - thread-scaling study of the host code (--scaling, --pinning)
+    - functional model of the kernels (--model)
+    - address distribution of the updates (--distribution, --zipf-s,
+      --hot-fraction, --hot-probability, --bank-bias)
+    - co-execution on the device and the host (--hybrid, --hybrid-balance,
+      --hybrid-threads)
+    - hardware counters of the host phases (--perf)
+    - multiple tenants with independent tables (--tenants)
+    - sequential kernel launches from a single thread (--serial-launch)
+    - comparison of multiple kernel files (multiple -f)
+    - error heatmap of the replications and address regions (--heatmap,
+      --heatmap-file)
 @see https://github.com/jarro2783/cxxopts
 
 @return program settings that are created from the given program arguments
@@ -60,16 +90,35 @@ parseProgramParameters(int argc, char * argv[]) {
     // Defining and parsing program options
     cxxopts::Options options(argv[0], PROGRAM_DESCRIPTION);
     options.add_options()
-        ("f,file", "Kernel file name", cxxopts::value<std::string>())
+        ("f,file", "Kernel file name. Can be given multiple times to "\
+        "execute and compare multiple kernel files one after another",
+            cxxopts::value<std::vector<std::string>>())
         ("n", "Number of repetitions",
                 cxxopts::value<uint>()->default_value(std::to_string(NTIMES)))
+        ("warmup", "Number of additional kernel executions before the "\
+        "measurement that are excluded from the results",
+                cxxopts::value<uint>()->default_value("0"))
+        ("rse", "Repeat the kernel execution until the relative standard "\
+        "error of the kernel time drops below the given value (e.g. 0.01). "\
+        "The number of repetitions given with -n is used as minimum.",
+                cxxopts::value<double>()->default_value("0"))
+        ("max-repetitions", "Maximum number of repetitions used with --rse",
+                cxxopts::value<uint>()->default_value("100"))
         ("r", "Number of used kernel replications",
             cxxopts::value<uint>()->default_value(std::to_string(REPLICATIONS)))
-        ("d,data", "Size of the used data array (Should be half of the "\
-                       "available global memory)",
-                cxxopts::value<size_t>()
-                                ->default_value(std::to_string(DATA_LENGTH)))
-        ("i,nointerleaving", "Disable memory interleaving")
+        ("d,data", "Number of entries of the used data array (Should be "\
+        "half of the available global memory)",
+                cxxopts::value<size_t>()->default_value(
+                                std::to_string(DATA_LENGTH / ENTRY_WIDTH)))
+        ("i,nointerleaving", "Disable memory interleaving. Same as "\
+        "--placement round-robin")
+        ("placement", "Placement of the data of the replications in the "\
+        "memory banks: interleaved, round-robin, sub-buffers or a comma "\
+        "separated list with the bank of every replication (e.g. 1,2,1,2)",
+            cxxopts::value<std::string>()->default_value("interleaved"))
+        ("banks", "Number of memory banks used by the round-robin "\
+        "placement. If 0, every replication gets its own bank.",
+            cxxopts::value<uint>()->default_value("0"))
         ("device", "Index of the device that has to be used. If not given you "\
         "will be asked which device to use if there are multiple devices "\
         "available.", cxxopts::value<int>()->default_value(std::to_string(-1)))
@@ -77,11 +126,115 @@ parseProgramParameters(int argc, char * argv[]) {
         "you will be asked which platform to use if there are multiple "\
         "platforms available.",
             cxxopts::value<int>()->default_value(std::to_string(-1)))
+        ("soak", "Execute the kernels repeatedly for the given number of "\
+        "seconds instead of the given number of repetitions and print the "\
+        "throughput over time", cxxopts::value<double>()->default_value("0"))
+        ("soak-ci", "Stop the soak run early when the half width of the 95% "\
+        "confidence interval of the GUOPS drops below the given fraction of "\
+        "the mean (e.g. 0.001)",
+            cxxopts::value<double>()->default_value("0"))
+        ("soak-interval", "Minimum time in seconds covered by a throughput "\
+        "sample of the soak run",
+            cxxopts::value<double>()->default_value("10"))
+        ("trace", "Write a trace of all phases of the run to the given file. "\
+        "It can be viewed in chrome://tracing or Perfetto.",
+            cxxopts::value<std::string>()->default_value(""))
+        ("bandwidth", "Measure the sequential memory bandwidth before the "\
+        "random accesses and report the efficiency of the random accesses. "\
+        "Needs kernels synthesized with BANDWIDTH_KERNEL.")
+        ("latency", "Measure the latency of dependent reads in every memory "\
+        "bank with a pointer chase before the random accesses. "\
+        "Needs kernels synthesized with LATENCY_KERNEL.")
+        ("operation", "Operation the kernels use to update the data. It has "\
+        "to match the synthesized kernels. One of xor, add, scatter, gather "\
+        "or cas.",
+            cxxopts::value<std::string>()
+                                ->default_value(operationName(OPERATION)))
+        ("out-of-core", "Keep the data array in host memory and process it "\
+        "in passes over windows of the given number of items on the device. "\
+        "Needs kernels synthesized with OUT_OF_CORE_KERNEL.",
+            cxxopts::value<size_t>()->default_value("0"))
+        ("table-file", "Map the data array of the out-of-core mode from the "\
+        "given file instead of allocating it in host memory",
+            cxxopts::value<std::string>()->default_value(""))
+        ("type", "Type of the kernels in the kernel file: single, "\
+        "single_fwd, single_sorted, single_cached, single_rnd or ndrange",
+            cxxopts::value<std::string>()->default_value(STR(KERNEL_TYPE)))
+        ("compare", "Compare the results with the row of the baseline file "\
+        "with the given key (e.g. 19.1.0_single) and exit with an error "\
+        "code if they regressed",
+            cxxopts::value<std::string>()->default_value(""))
+        ("compare-board", "Board of the baseline row used with --compare",
+            cxxopts::value<std::string>()->default_value(""))
+        ("baseline-file", "CSV file containing the baselines",
+            cxxopts::value<std::string>()
+                                ->default_value(DEFAULT_BASELINE_FILE))
+        ("max-drop", "Maximum allowed relative drop of the GUOPS compared "\
+        "to the baseline",
+            cxxopts::value<double>()->default_value("0.05"))
+        ("max-error-increase", "Maximum allowed increase of the error rate "\
+        "in percent points compared to the baseline",
+            cxxopts::value<double>()->default_value("0.01"))
+        ("scaling", "Execute the updates and the verification on the host "\
+        "with 1, 2, 4, ... up to the given number of threads instead of "\
+        "the kernels and print strong- and weak-scaling tables. No kernel "\
+        "file is needed.",
+            cxxopts::value<uint>()->default_value("0"))
+        ("pinning", "Pinning of the threads of the scaling study to the "\
+        "CPUs: none, compact or scatter",
+            cxxopts::value<std::string>()->default_value("none"))
+        ("model", "Execute a functional model of the kernels of the given "\
+        "type on the host instead of the device. No kernel file is needed. "\
+        "Available for single, single_fwd, single_sorted and "\
+        "single_cached.")
+        ("distribution", "Address distribution of the updates: uniform, "\
+        "zipf or hotset. Needs kernels synthesized with "\
+        "ADDRESS_DISTRIBUTION unless it is uniform.",
+            cxxopts::value<std::string>()->default_value("uniform"))
+        ("zipf-s", "Exponent of the zipf distribution",
+            cxxopts::value<double>()->default_value("0.99"))
+        ("hot-fraction", "Fraction of the entries in the hot set of the "\
+        "hotset distribution",
+            cxxopts::value<double>()->default_value("0.1"))
+        ("hot-probability", "Fraction of the updates to the hot set of the "\
+        "hotset distribution",
+            cxxopts::value<double>()->default_value("0.9"))
+        ("bank-bias", "Comma separated weights of the data chunks of all "\
+        "replications (e.g. 4,1,1,1) to concentrate the updates in some "\
+        "memory banks",
+            cxxopts::value<std::string>()->default_value(""))
+        ("hybrid", "Update the given fraction of the data array with a "\
+        "multi-threaded engine on the host while the kernels update the rest",
+            cxxopts::value<double>()->default_value("0"))
+        ("hybrid-balance", "Adjust the fraction of the host from the "\
+        "measured rates of the device and the host, so both finish at the "\
+        "same time. Starts with the fraction given with --hybrid.")
+        ("hybrid-threads", "Number of threads of the host engine used with "\
+        "--hybrid. If 0, all available CPUs are used.",
+            cxxopts::value<uint>()->default_value("0"))
+        ("perf", "Measure hardware counters of the host phases like the "\
+        "initialization and the verification with perf_event_open")
+        ("tenants", "Update the given number of independent tables "\
+        "concurrently with one kernel per table and report the GUOPS of "\
+        "every tenant. Needs kernels synthesized with MULTI_TENANT_KERNEL.",
+            cxxopts::value<uint>()->default_value("0"))
+        ("serial-launch", "Launch the kernels of all replications one after "\
+        "another from a single thread and wait for them in order instead of "\
+        "using one launch thread per replication")
+        ("heatmap", "Count the wrong entries in the chunk of every "\
+        "replication and in the given number of equally sized address "\
+        "regions and print them as heatmap together with the GUOPS of "\
+        "every replication. Has to be a power of two.",
+            cxxopts::value<uint>()->default_value("0"))
+        ("heatmap-file", "Also write the values of the heatmap to the "\
+        "given JSON file",
+            cxxopts::value<std::string>()->default_value(""))
         ("h,help", "Print this help");
     cxxopts::ParseResult result = options.parse(argc, argv);
 
     // Check parsed options and handle special cases
-    if (result.count("f") <= 0) {
+    if (result.count("f") <= 0 && result["scaling"].as<uint>() == 0
+            && result.count("model") <= 0) {
         // Path to the kernel file is mandatory - exit if not given!
         std::cerr << "Kernel file must be given! Aborting" << std::endl;
         std::cout << options.help() << std::endl;
@@ -93,17 +246,226 @@ parseProgramParameters(int argc, char * argv[]) {
         exit(0);
     }
 
+    int operation = operationFromName(result["operation"].as<std::string>());
+    if (operation < 0) {
+        std::cerr << "Unknown operation "
+                  << result["operation"].as<std::string>() << "! Aborting"
+                  << std::endl;
+        exit(1);
+    }
+
+    if (result["out-of-core"].as<size_t>() > 0 && ENTRY_WIDTH > 1) {
+        std::cerr << "The out-of-core mode does not support entries of "
+                  << ENTRY_WIDTH << " words! Aborting" << std::endl;
+        exit(1);
+    }
+
+    std::string placement = result["placement"].as<std::string>();
+    if (result.count("i") > 0 && placement == "interleaved") {
+        placement = "round-robin";
+    }
+
+    if (!bm_execution::isKernelType(result["type"].as<std::string>())) {
+        std::cerr << "Unknown kernel type "
+                  << result["type"].as<std::string>() << "! Aborting"
+                  << std::endl;
+        exit(1);
+    }
+
+    std::string distribution = result["distribution"].as<std::string>();
+    if (!bm_distribution::isDistribution(distribution)) {
+        std::cerr << "Unknown distribution " << distribution << "! Aborting"
+                  << std::endl;
+        exit(1);
+    }
+    bool skewed = distribution != "uniform"
+                    || !result["bank-bias"].as<std::string>().empty();
+    if (skewed && result["out-of-core"].as<size_t>() > 0) {
+        std::cerr << "The address distribution is not supported by the "
+                  << "out-of-core mode! Aborting" << std::endl;
+        exit(1);
+    }
+#ifndef ADDRESS_DISTRIBUTION
+    if (skewed && result["scaling"].as<uint>() == 0
+            && result.count("model") <= 0) {
+        std::cerr << "The kernels have to be synthesized with "
+                  << "ADDRESS_DISTRIBUTION to use the distribution "
+                  << distribution << "! Aborting" << std::endl;
+        exit(1);
+    }
+#endif
+
+    double hostFraction = result["hybrid"].as<double>();
+    bool hybrid = hostFraction > 0 || result.count("hybrid-balance") > 0;
+    if (hostFraction < 0 || hostFraction >= 1) {
+        std::cerr << "The fraction of the host has to be in [0,1)! Aborting"
+                  << std::endl;
+        exit(1);
+    }
+    if (hybrid && (result["out-of-core"].as<size_t>() > 0
+                   || result.count("model") > 0)) {
+        std::cerr << "The co-execution on the host is not supported by the "
+                  << "out-of-core mode and the model! Aborting" << std::endl;
+        exit(1);
+    }
+
+    uint tenants = result["tenants"].as<uint>();
+    if ((tenants & (tenants - 1)) != 0) {
+        // The tables of the tenants have to be powers of two
+        std::cerr << "The number of tenants has to be a power of two! "
+                  << "Aborting" << std::endl;
+        exit(1);
+    }
+    if (tenants > 0 && (skewed || hybrid
+                        || result["out-of-core"].as<size_t>() > 0
+                        || result.count("model") > 0)) {
+        std::cerr << "The multi-tenant mode is not supported together with "
+                  << "the address distribution, the co-execution on the "
+                  << "host, the out-of-core mode and the model! Aborting"
+                  << std::endl;
+        exit(1);
+    }
+
+    std::vector<std::string> kernelFileNames;
+    if (result.count("f") > 0) {
+        kernelFileNames = result["f"].as<std::vector<std::string>>();
+    }
+    if (kernelFileNames.size() > 1
+            && (!result["compare"].as<std::string>().empty()
+                || result["out-of-core"].as<size_t>() > 0
+                || result.count("model") > 0)) {
+        std::cerr << "Multiple kernel files can not be used together with "
+                  << "the regression gate, the out-of-core mode and the "
+                  << "model! Aborting" << std::endl;
+        exit(1);
+    }
+
+    uint heatmapRegions = result["heatmap"].as<uint>();
+    std::string heatmapFileName = result["heatmap-file"].as<std::string>();
+    if ((heatmapRegions & (heatmapRegions - 1)) != 0
+            || heatmapRegions > result["d"].as<size_t>()) {
+        std::cerr << "The number of heatmap regions has to be a power of two "
+                  << "and at most the size of the data array! Aborting"
+                  << std::endl;
+        exit(1);
+    }
+    if (!heatmapFileName.empty() && heatmapRegions == 0) {
+        std::cerr << "The heatmap file needs the number of regions given "
+                  << "with --heatmap! Aborting" << std::endl;
+        exit(1);
+    }
+    if (heatmapRegions > 0 && (hybrid || tenants > 0
+                               || result["out-of-core"].as<size_t>() > 0
+                               || result["scaling"].as<uint>() > 0)) {
+        std::cerr << "The error heatmap is not supported together with the "
+                  << "co-execution on the host, the multi-tenant mode, the "
+                  << "out-of-core mode and the scaling study! Aborting"
+                  << std::endl;
+        exit(1);
+    }
+    if (!heatmapFileName.empty() && kernelFileNames.size() > 1) {
+        std::cerr << "The heatmap file can not be written for multiple "
+                  << "kernel files! Aborting" << std::endl;
+        exit(1);
+    }
+
+    if (!bm_scaling::isPinningPolicy(result["pinning"].as<std::string>())) {
+        std::cerr << "Unknown pinning policy "
+                  << result["pinning"].as<std::string>() << "! Aborting"
+                  << std::endl;
+        exit(1);
+    }
+
     // Create program settings from program arguments
     std::shared_ptr<ProgramSettings> sharedSettings(
-            new ProgramSettings {result["n"].as<uint>(), result["r"].as<uint>(),
+            new ProgramSettings {result["n"].as<uint>(),
+                                result["warmup"].as<uint>(),
+                                result["max-repetitions"].as<uint>(),
+                                result["rse"].as<double>(),
+                                result["r"].as<uint>(),
                                 result["platform"].as<int>(),
                                 result["device"].as<int>(),
                                 result["d"].as<size_t>(),
-                                static_cast<bool>(result.count("i") <= 0),
-                                result["f"].as<std::string>()});
+                                placement == "interleaved",
+                                placement,
+                                result["banks"].as<uint>(),
+                                kernelFileNames.empty()
+                                    ? "" : kernelFileNames[0],
+                                result["soak"].as<double>(),
+                                result["soak-ci"].as<double>(),
+                                result["soak-interval"].as<double>(),
+                                result["trace"].as<std::string>(),
+                                static_cast<bool>(result.count("bandwidth")),
+                                static_cast<bool>(result.count("latency")),
+                                operation,
+                                result["out-of-core"].as<size_t>(),
+                                result["table-file"].as<std::string>(),
+                                result["type"].as<std::string>(),
+                                result["compare"].as<std::string>(),
+                                result["compare-board"].as<std::string>(),
+                                result["baseline-file"].as<std::string>(),
+                                result["max-drop"].as<double>(),
+                                result["max-error-increase"].as<double>(),
+                                result["scaling"].as<uint>(),
+                                result["pinning"].as<std::string>(),
+                                static_cast<bool>(result.count("model")),
+                                distribution,
+                                result["zipf-s"].as<double>(),
+                                result["hot-fraction"].as<double>(),
+                                result["hot-probability"].as<double>(),
+                                result["bank-bias"].as<std::string>(),
+                                hostFraction,
+                                static_cast<bool>(
+                                        result.count("hybrid-balance")),
+                                result["hybrid-threads"].as<uint>(),
+                                static_cast<bool>(result.count("perf")),
+                                tenants,
+                                static_cast<bool>(
+                                    result.count("serial-launch")),
+                                heatmapRegions,
+                                heatmapFileName,
+                                kernelFileNames});
+    // The kernels of multiple files are checked with the type and
+    // replications detected for every file
+    if (kernelFileNames.size() <= 1) {
+        checkKernelSettings(*sharedSettings, sharedSettings->kernelType,
+                            sharedSettings->numReplications);
+    }
     return sharedSettings;
 }
 
+/*
+ @copydoc checkKernelSettings()
+*/
+void
+checkKernelSettings(ProgramSettings const &settings,
+                    std::string const &kernelType, uint replications) {
+    bool skewed = settings.distribution != "uniform"
+                    || !settings.bankBias.empty();
+    bool hybrid = settings.hostFraction > 0 || settings.balanceHybrid;
+    bool streamKernel = kernelType == "single_rnd" || kernelType == "ndrange";
+    if (skewed && streamKernel) {
+        throw std::runtime_error("The address distribution is not "
+                                 "supported by the kernel type "
+                                 + kernelType);
+    }
+    if (hybrid && streamKernel) {
+        throw std::runtime_error("The co-execution on the host is not "
+                                 "supported by the kernel type "
+                                 + kernelType);
+    }
+    if (hybrid && replications == 1) {
+        // The kernel of a single replication updates the whole data array
+        throw std::runtime_error("The co-execution on the host needs "
+                                 "kernels with more than one replication");
+    }
+    if (settings.tenants > replications) {
+        throw std::runtime_error("The number of tenants has to be at most "
+                                 "the number of replications ("
+                                 + std::to_string(replications) + ")");
+    }
+}
+
 /**
 Print the benchmark Results
 
@@ -117,12 +479,15 @@ printResults(std::shared_ptr<bm_execution::ExecutionResults> results,
     std::cout << std::setw(ENTRY_SPACE)
               << "best" << std::setw(ENTRY_SPACE) << "mean"
               << std::setw(ENTRY_SPACE) << "GUOPS"
+              << std::setw(ENTRY_SPACE) << "GB/s"
               << std::setw(ENTRY_SPACE) << "error" << std::endl;
 
     // Calculate performance for kernel execution plus data transfer
     double tmean = 0;
     double tmin = std::numeric_limits<double>::max();
     double gups = static_cast<double>(4 * dataSize) / 1000000000;
+    // Every update reads and writes a whole entry
+    double gigabytes = 2.0 * ENTRY_SIZE * gups;
     for (double currentTime : results->times) {
         tmean +=  currentTime;
         if (currentTime < tmin) {
@@ -134,132 +499,291 @@ printResults(std::shared_ptr<bm_execution::ExecutionResults> results,
     std::cout << std::setw(ENTRY_SPACE)
               << tmin << std::setw(ENTRY_SPACE) << tmean
               << std::setw(ENTRY_SPACE) << gups / tmin
+              << std::setw(ENTRY_SPACE) << gigabytes / tmin
               << std::setw(ENTRY_SPACE) << (100.0 * results->errorRate)
               << std::endl;
-}
-
-/**
- Generates the value of the random number after a desired number of updates
-
- @param n number of random number updates
 
- @return The random number after n number of updates
- */
-DATA_TYPE_UNSIGNED
-starts(DATA_TYPE n) {
-    DATA_TYPE_UNSIGNED m2[BIT_SIZE];
+    // Robust statistics of the kernel times
+    std::vector<double> filteredTimes =
+                            bm_statistics::rejectOutliers(results->times);
+    std::cout << std::setw(ENTRY_SPACE) << "median"
+              << std::setw(ENTRY_SPACE) << "MAD"
+              << std::setw(ENTRY_SPACE) << "rel. SE"
+              << std::setw(ENTRY_SPACE) << "outliers"
+              << std::setw(ENTRY_SPACE) << "clean mean"
+              << std::setw(ENTRY_SPACE) << "repetitions" << std::endl;
+    std::cout << std::setw(ENTRY_SPACE)
+              << bm_statistics::median(results->times)
+              << std::setw(ENTRY_SPACE)
+              << bm_statistics::medianAbsoluteDeviation(results->times)
+              << std::setw(ENTRY_SPACE)
+              << bm_statistics::relativeStandardError(filteredTimes)
+              << std::setw(ENTRY_SPACE)
+              << results->times.size() - filteredTimes.size()
+              << std::setw(ENTRY_SPACE)
+              << bm_statistics::mean(filteredTimes)
+              << std::setw(ENTRY_SPACE) << results->times.size()
+              << std::endl;
 
-    while (n < 0) {
-        n += PERIOD;
+    if (results->bandwidth) {
+        printBandwidthResults(results, dataSize);
     }
-    while (n > 0) {
-        n -= PERIOD;
+    if (results->latency) {
+        printLatencyResults(results);
     }
-
-    if (n == 0) {
-        return 1;
+    if (results->hybrid) {
+        printHybridResults(results);
     }
-
-    DATA_TYPE_UNSIGNED temp = 1;
-    for (int i=0; i < BIT_SIZE; i++) {
-        m2[i] = temp;
-        for (int j=0; j < 2; j++) {
-            DATA_TYPE v = 0;
-            if (((DATA_TYPE) temp) < 0) {
-                v = POLY;
-            }
-            temp = (temp << 1) ^ v;
-        }
+    if (results->tenants) {
+        printTenantResults(results);
     }
-    // DATA_TYPE i = BIT_SIZE - 2;
-    // while (i >= 0 && !((n >> i) & 1)) {
-    //     i--;
-    // }
-    int i = 0;
-    for (i=BIT_SIZE - 2; i >= 0; i--) {
-        if ((n >> i) & 1) {
-            break;
-        }
+    if (results->launch) {
+        printLaunchResults(results);
     }
+    if (results->errorMap) {
+        bm_heatmap::printHeatmap(results, dataSize);
+    }
+    if (!results->phaseCounters.empty()) {
+        printCounterResults(results);
+    }
+}
 
-    DATA_TYPE_UNSIGNED ran = 2;
-    while (i > 0) {
-        temp = 0;
-        for (int j=0; j < BIT_SIZE; j++) {
-            if ((ran >> j) & 1) {
-                temp ^= m2[j];
-            }
-        }
-        ran = temp;
-        i--;
-        if ((n >> i) & 1) {
-            DATA_TYPE v = 0;
-            if (((DATA_TYPE) ran) < 0) {
-                v = POLY;
-            }
-            ran = (ran << 1) ^v;
+/**
+Print the sequential bandwidth baseline and the efficiency of the random
+accesses for every memory bank
+
+@param results The result struct provided by the calculation call
+@param dataSize The size of the used data array
+*/
+void
+printBandwidthResults(std::shared_ptr<bm_execution::ExecutionResults> results,
+                      size_t dataSize) {
+    size_t replications = results->bandwidth->bankTimes.size();
+    double tmin = *std::min_element(results->times.begin(),
+                                    results->times.end());
+    // Every update and every streamed entry is read and written once
+    double bankBytes = 2.0 * ENTRY_SIZE * dataSize / replications;
+    double randomBankBandwidth = 4 * bankBytes / tmin / 1.0e9;
+
+    std::cout << HLINE << "Bandwidth baseline:" << std::endl
+              << std::setw(ENTRY_SPACE) << "bank"
+              << std::setw(ENTRY_SPACE) << "stream GB/s"
+              << std::setw(ENTRY_SPACE) << "random GB/s"
+              << std::setw(ENTRY_SPACE) << "efficiency" << std::endl;
+    for (size_t r = 0; r < replications; r++) {
+        double streamBandwidth = bankBytes
+                        / results->bandwidth->bankTimes[r] / 1.0e9;
+        std::cout << std::setw(ENTRY_SPACE) << r
+                  << std::setw(ENTRY_SPACE) << streamBandwidth
+                  << std::setw(ENTRY_SPACE) << randomBankBandwidth
+                  << std::setw(ENTRY_SPACE)
+                  << randomBankBandwidth / streamBandwidth << std::endl;
+    }
+    double streamBandwidth = bankBytes * replications
+                        / results->bandwidth->concurrentTime / 1.0e9;
+    std::cout << std::setw(ENTRY_SPACE) << "all"
+              << std::setw(ENTRY_SPACE) << streamBandwidth
+              << std::setw(ENTRY_SPACE) << randomBankBandwidth * replications
+              << std::setw(ENTRY_SPACE)
+              << randomBankBandwidth * replications / streamBandwidth
+              << std::endl;
+}
+
+/**
+Print the latency of dependent reads for every memory bank and pointer chain
+size
+
+@param results The result struct provided by the calculation call
+*/
+void
+printLatencyResults(std::shared_ptr<bm_execution::ExecutionResults> results) {
+    std::cout << HLINE << "Latency of dependent reads in ns:" << std::endl
+              << std::setw(ENTRY_SPACE) << "size (Byte)";
+    for (size_t r = 0; r < results->latency->latencies[0].size(); r++) {
+        std::cout << std::setw(ENTRY_SPACE) << "bank " + std::to_string(r);
+    }
+    std::cout << std::endl;
+    for (size_t i = 0; i < results->latency->sizes.size(); i++) {
+        std::cout << std::setw(ENTRY_SPACE)
+                  << results->latency->sizes[i] * sizeof(DATA_TYPE);
+        for (double latency : results->latency->latencies[i]) {
+            std::cout << std::setw(ENTRY_SPACE) << latency;
         }
+        std::cout << std::endl;
     }
-    return ran;
 }
 
+/**
+Print the split of the data array and the best times and GUOPS of the device
+and the host of a co-execution
+
+@param results The result struct provided by the calculation call
+*/
+void
+printHybridResults(std::shared_ptr<bm_execution::ExecutionResults> results) {
+    bm_execution::HybridResults const &hybrid = *results->hybrid;
+    double deviceMin = *std::min_element(hybrid.deviceTimes.begin(),
+                                         hybrid.deviceTimes.end());
+    double hostMin = *std::min_element(hybrid.hostTimes.begin(),
+                                       hybrid.hostTimes.end());
+    double tmin = *std::min_element(results->times.begin(),
+                                    results->times.end());
+    size_t updates = hybrid.deviceUpdates + hybrid.hostUpdates;
+    std::cout << HLINE << "Co-execution with " << hybrid.hostThreads
+              << " host threads:" << std::endl
+              << std::setw(ENTRY_SPACE) << "side"
+              << std::setw(ENTRY_SPACE) << "entries"
+              << std::setw(ENTRY_SPACE) << "updates"
+              << std::setw(ENTRY_SPACE) << "best"
+              << std::setw(ENTRY_SPACE) << "GUOPS" << std::endl;
+    std::cout << std::setw(ENTRY_SPACE) << "device"
+              << std::setw(ENTRY_SPACE) << hybrid.deviceEntries
+              << std::setw(ENTRY_SPACE) << hybrid.deviceUpdates
+              << std::setw(ENTRY_SPACE) << deviceMin
+              << std::setw(ENTRY_SPACE)
+              << hybrid.deviceUpdates / deviceMin / 1.0e9 << std::endl;
+    std::cout << std::setw(ENTRY_SPACE) << "host"
+              << std::setw(ENTRY_SPACE) << hybrid.hostEntries
+              << std::setw(ENTRY_SPACE) << hybrid.hostUpdates
+              << std::setw(ENTRY_SPACE) << hostMin
+              << std::setw(ENTRY_SPACE)
+              << hybrid.hostUpdates / hostMin / 1.0e9 << std::endl;
+    std::cout << std::setw(ENTRY_SPACE) << "combined"
+              << std::setw(ENTRY_SPACE)
+              << hybrid.deviceEntries + hybrid.hostEntries
+              << std::setw(ENTRY_SPACE) << updates
+              << std::setw(ENTRY_SPACE) << tmin
+              << std::setw(ENTRY_SPACE) << updates / tmin / 1.0e9
+              << std::endl;
+}
 
 /**
-The program entry point.
-Prepares the FPGA and executes the kernels on the device.
+Print the best times, GUOPS and error rates of all tenants of the
+multi-tenant mode and the fairness between them
+
+@param results The result struct provided by the calculation call
 */
-int
-main(int argc, char * argv[]) {
-    // Setup benchmark
-    std::shared_ptr<ProgramSettings> programSettings =
-                                            parseProgramParameters(argc, argv);
-    fpga_setup::setupEnvironmentAndClocks();
-
-    std::vector<cl::Device> usedDevice;
-    cl::Context context;
-    cl::Program program;
-    cl::Device device;
-
-    if (programSettings->kernelFileName != "CPU") {
-        usedDevice = fpga_setup::selectFPGADevice(
-                                        programSettings->defaultPlatform,
-                                        programSettings->defaultDevice);
-        context = cl::Context(usedDevice);
-        const char* usedKernel = programSettings->kernelFileName.c_str();
-        program = fpga_setup::fpgaSetup(context, usedDevice, usedKernel);
-    }
-
-
-    // Give setup summary
-    std::cout << PROGRAM_DESCRIPTION << std::endl << HLINE;
-    std::cout << "Summary:" << std::endl
-              << "Kernel Replications: " << programSettings->numReplications
-              << std::endl
-              << "Repetitions:         " << programSettings->numRepetitions
-              << std::endl
-              << "Total data size:     " << (programSettings->dataSize
-                                            * sizeof(DATA_TYPE)) * 1.0
-                                         << " Byte" << std::endl
-              << "Memory Interleaving: " << programSettings->useMemInterleaving
+void
+printTenantResults(std::shared_ptr<bm_execution::ExecutionResults> results) {
+    bm_execution::TenantResults const &tenants = *results->tenants;
+    double const updates = 4.0 * tenants.tableSize;
+    std::cout << HLINE << "Multi-tenant execution with "
+              << tenants.times.size() << " tables of " << tenants.tableSize
+              << " entries:" << std::endl
+              << std::setw(ENTRY_SPACE) << "tenant"
+              << std::setw(ENTRY_SPACE) << "best"
+              << std::setw(ENTRY_SPACE) << "mean"
+              << std::setw(ENTRY_SPACE) << "GUOPS"
+              << std::setw(ENTRY_SPACE) << "error" << std::endl;
+    double minGuops = std::numeric_limits<double>::max();
+    double maxGuops = 0;
+    for (size_t t = 0; t < tenants.times.size(); t++) {
+        double tmin = *std::min_element(tenants.times[t].begin(),
+                                        tenants.times[t].end());
+        double guops = updates / tmin / 1.0e9;
+        minGuops = std::min(minGuops, guops);
+        maxGuops = std::max(maxGuops, guops);
+        std::cout << std::setw(ENTRY_SPACE) << t
+                  << std::setw(ENTRY_SPACE) << tmin
+                  << std::setw(ENTRY_SPACE)
+                  << bm_statistics::mean(tenants.times[t])
+                  << std::setw(ENTRY_SPACE) << guops
+                  << std::setw(ENTRY_SPACE)
+                  << 100.0 * tenants.errorRates[t] << std::endl;
+    }
+    double tmin = *std::min_element(results->times.begin(),
+                                    results->times.end());
+    std::cout << std::setw(ENTRY_SPACE) << "aggregate"
+              << std::setw(ENTRY_SPACE) << tmin
+              << std::setw(ENTRY_SPACE) << bm_statistics::mean(results->times)
+              << std::setw(ENTRY_SPACE)
+              << updates * tenants.times.size() / tmin / 1.0e9
+              << std::setw(ENTRY_SPACE) << 100.0 * results->errorRate
               << std::endl
-              << "Kernel file:         " << programSettings->kernelFileName
+              << "Fairness (min/max GUOPS): " << minGuops / maxGuops
               << std::endl;
-    if (usedDevice.size() > 0) {
-    std::cout << "Device:              "
-              << usedDevice[0].getInfo<CL_DEVICE_NAME>() << std::endl;
-              device = usedDevice[0];
-    }
-    std::cout << HLINE
-              << "Start benchmark using the given configuration." << std::endl
-              << HLINE;
+}
 
-    // Start actual benchmark
-    auto results = bm_execution::calculate(context, device, program,
-              programSettings->numRepetitions,
-              programSettings->numReplications, programSettings->dataSize,
-              programSettings->useMemInterleaving);
+/**
+Print the mean submission and finish times of the kernels of all
+replications and the launch skew between them
 
-    printResults(results, programSettings->dataSize);
+@param results The result struct provided by the calculation call
+*/
+void
+printLaunchResults(std::shared_ptr<bm_execution::ExecutionResults> results) {
+    bm_execution::LaunchResults const &launch = *results->launch;
+    std::cout << HLINE << "Kernel launches "
+              << (launch.serial ? "from a single thread:"
+                                : "with one thread per replication:")
+              << std::endl
+              << std::setw(ENTRY_SPACE) << "replication"
+              << std::setw(ENTRY_SPACE) << "start [us]"
+              << std::setw(ENTRY_SPACE) << "finish [s]" << std::endl;
+    for (size_t r = 0; r < launch.startOffsets.size(); r++) {
+        std::cout << std::setw(ENTRY_SPACE) << r
+                  << std::setw(ENTRY_SPACE) << 1.0e6 * launch.startOffsets[r]
+                  << std::setw(ENTRY_SPACE) << launch.finishTimes[r]
+                  << std::endl;
+    }
+    auto start = std::minmax_element(launch.startOffsets.begin(),
+                                     launch.startOffsets.end());
+    std::cout << "Launch skew: " << 1.0e6 * (*start.second - *start.first)
+              << " us" << std::endl;
+}
+
+/**
+Print the hardware counters of every host phase. Unavailable counters are
+printed as n/a.
 
-    return 0;
+@param results The result struct provided by the calculation call
+*/
+void
+printCounterResults(std::shared_ptr<bm_execution::ExecutionResults> results) {
+    int const nameSpace = 2 * ENTRY_SPACE;
+    std::cout << HLINE << "Hardware counters of the host phases:" << std::endl
+              << std::left << std::setw(nameSpace) << "phase" << std::right
+              << std::setw(ENTRY_SPACE) << "time"
+              << std::setw(ENTRY_SPACE) << "cycles"
+              << std::setw(ENTRY_SPACE) << "instructions"
+              << std::setw(ENTRY_SPACE) << "IPC"
+              << std::setw(ENTRY_SPACE) << "LLC misses"
+              << std::setw(ENTRY_SPACE) << "dTLB misses"
+              << std::setw(ENTRY_SPACE) << "memory GB/s" << std::endl;
+    for (bm_perf::PhaseCounters const &phase : results->phaseCounters) {
+        std::vector<int64_t> const &v = phase.values;
+        std::cout << std::left << std::setw(nameSpace)
+                  << phase.name + " (" + std::to_string(phase.calls) + ")"
+                  << std::right << std::setw(ENTRY_SPACE) << phase.seconds;
+        for (int c : {PERF_CYCLES, PERF_INSTRUCTIONS}) {
+            std::cout << std::setw(ENTRY_SPACE);
+            if (v[c] < 0) {
+                std::cout << "n/a";
+            } else {
+                std::cout << static_cast<double>(v[c]);
+            }
+        }
+        std::cout << std::setw(ENTRY_SPACE);
+        if (v[PERF_CYCLES] > 0 && v[PERF_INSTRUCTIONS] >= 0) {
+            std::cout << static_cast<double>(v[PERF_INSTRUCTIONS])
+                            / v[PERF_CYCLES];
+        } else {
+            std::cout << "n/a";
+        }
+        for (int c : {PERF_LLC_LOAD_MISSES, PERF_DTLB_LOAD_MISSES}) {
+            std::cout << std::setw(ENTRY_SPACE);
+            if (v[c] < 0) {
+                std::cout << "n/a";
+            } else {
+                std::cout << static_cast<double>(v[c]);
+            }
+        }
+        std::cout << std::setw(ENTRY_SPACE);
+        if (v[PERF_MEMORY_BYTES] >= 0 && phase.seconds > 0) {
+            std::cout << v[PERF_MEMORY_BYTES] / phase.seconds / 1.0e9;
+        } else {
+            std::cout << "n/a";
+        }
+        std::cout << std::endl;
+    }
 }
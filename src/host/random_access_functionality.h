@@ -25,9 +25,12 @@ SOFTWARE.
 
 /* C++ standard library headers */
 #include <memory>
+#include <string>
+#include <vector>
 
 /* Project's headers */
 #include "src/host/execution.h"
+#include "src/host/random_access_definitions.h"
 
 /*
 Short description of the program.
@@ -41,15 +44,6 @@ Moreover the version and build time is also compiled into the description.
                             "Version: " STR(VERSION) "\nBuild date: "\
                             STR(BUILD_DATE)
 
-/**
-Total length of the data array used for random accesses.
-The array should allocate half of the available global memory space.
-Keep in mind that this also depends on DATA_TYPE.
-*/
-#ifndef DATA_LENGTH
-#define DATA_LENGTH 67108864
-#endif
-
 /**
 Number of times the execution of the benchmark will be repeated.
 */
@@ -58,43 +52,58 @@ Number of times the execution of the benchmark will be repeated.
 #endif
 
 /**
-The data type used for the random accesses.
-Note that it should be big enough to address the whole data array. Moreover it
-has to be the same type as in the used kernels.
-The signed and unsigned form of the data type have to be given separately.
+Kernel type that is used if no type is given on the command line. It is set
+to the TYPE the host was built with.
 */
-#ifndef DATA_TYPE
-    #define DATA_TYPE cl_long
-#endif
-#ifndef DATA_TYPE_UNSIGNED
-#define DATA_TYPE_UNSIGNED cl_ulong
+#ifndef KERNEL_TYPE
+#define KERNEL_TYPE single
 #endif
 
-/**
-Prefix of the function name of the used kernel.
-It will be used to construct the full function name for the case of replications.
-The full name will be
-*/
-#define RANDOM_ACCESS_KERNEL "accessMemory"
-
-/**
-Constants used to verify benchmark results
-*/
-#define POLY 7
-#define PERIOD 1317624576693539401L
-
-#define BIT_SIZE (sizeof(DATA_TYPE) * 8)
-
-#define ENTRY_SPACE 13
-
 struct ProgramSettings {
     uint numRepetitions;
+    uint numWarmupRepetitions;
+    uint maxRepetitions;
+    double targetRSE;
     uint numReplications;
     int defaultPlatform;
     int defaultDevice;
     size_t dataSize;
     bool useMemInterleaving;
+    std::string placement;
+    uint numBanks;
     std::string kernelFileName;
+    double soakDuration;
+    double soakConfidence;
+    double soakInterval;
+    std::string traceFileName;
+    bool measureBandwidth;
+    bool measureLatency;
+    int operation;
+    size_t windowSize;
+    std::string tableFileName;
+    std::string kernelType;
+    std::string baselineKey;
+    std::string baselineBoard;
+    std::string baselineFileName;
+    double maxGuopsDrop;
+    double maxErrorIncrease;
+    uint scalingThreads;
+    std::string pinning;
+    bool useModel;
+    std::string distribution;
+    double zipfExponent;
+    double hotFraction;
+    double hotProbability;
+    std::string bankBias;
+    double hostFraction;
+    bool balanceHybrid;
+    uint hostThreads;
+    bool perfCounters;
+    uint tenants;
+    bool serialLaunch;
+    uint heatmapRegions;
+    std::string heatmapFileName;
+    std::vector<std::string> kernelFileNames;
 };
 
 
@@ -103,9 +112,32 @@ Parses and returns program options using the cxxopts library.
 Supports the following parameters:
     - file name of the FPGA kernel file (-f,--file)
     - number of repetitions (-n)
+    - warm-up and adaptive repetitions (--warmup, --rse, --max-repetitions)
     - number of kernel replications (-r)
     - data size (-d)
     - use memory interleaving
+    - soak run duration, confidence and sample interval (--soak*)
+    - trace file (--trace)
+    - measure bandwidth baseline (--bandwidth)
+    - measure latency of dependent reads (--latency)
+    - update operation (--operation)
+    - placement of the data in the memory banks (--placement, --banks)
+    - out-of-core mode (--out-of-core, --table-file)
+    - kernel type of the bitstream (--type)
+    - comparison with a baseline (--compare, --compare-board,
+      --baseline-file, --max-drop, --max-error-increase)
+    - thread-scaling study of the host code (--scaling, --pinning)
+    - functional model of the kernels (--model)
+    - address distribution of the updates (--distribution, --zipf-s,
+      --hot-fraction, --hot-probability, --bank-bias)
+    - co-execution on the device and the host (--hybrid, --hybrid-balance,
+      --hybrid-threads)
+    - hardware counters of the host phases (--perf)
+    - multiple tenants with independent tables (--tenants)
+    - sequential kernel launches from a single thread (--serial-launch)
+    - comparison of multiple kernel files (multiple -f)
+    - error heatmap of the replications and address regions (--heatmap,
+      --heatmap-file)
 @see https://github.com/jarro2783/cxxopts
 
 @return program settings that are created from the given program arguments
@@ -115,29 +147,85 @@ parseProgramParameters(int argc, char * argv[]);
 
 
 /**
- Generates the value of the random number after a desired number of updates
-
- @param n number of random number updates
+Checks if the kernels of the given type and number of replications can be
+used with the program settings. Throws std::runtime_error if the address
+distribution, the co-execution on the host or the multi-tenant mode are not
+supported by the kernels.
+
+@param settings The program settings
+@param kernelType The type of the used kernels, e.g. "single"
+@param replications Number of used kernel replications
+*/
+void
+checkKernelSettings(ProgramSettings const &settings,
+                    std::string const &kernelType, uint replications);
 
- @return The random number after n number of updates
- */
-DATA_TYPE_UNSIGNED
-starts(DATA_TYPE n);
 
 /**
 Prints the execution results to stdout
 
 @param results The execution results
-@param dataSize Size of the used data array. Needed to calculate GUOP/s from
+@param dataSize Number of entries of the used data array. Needed to
+                calculate GUOP/s and the bandwidth of the updates from
                 timings
 */
 void printResults(std::shared_ptr<bm_execution::ExecutionResults> results,
                   size_t dataSize);
 
+/**
+Prints the sequential bandwidth baseline and the efficiency of the random
+accesses to stdout
+
+@param results The execution results containing the bandwidth results
+@param dataSize Size of the used data array
+*/
+void printBandwidthResults(
+                  std::shared_ptr<bm_execution::ExecutionResults> results,
+                  size_t dataSize);
 
 /**
-The program entry point
+Prints the latency of dependent reads for every memory bank and pointer chain
+size to stdout
+
+@param results The execution results containing the latency results
+*/
+void printLatencyResults(
+                  std::shared_ptr<bm_execution::ExecutionResults> results);
+
+/**
+Prints the split of the data array and the best times and GUOPS of the
+device and the host of a co-execution to stdout
+
+@param results The execution results containing the co-execution results
+*/
+void printHybridResults(
+                  std::shared_ptr<bm_execution::ExecutionResults> results);
+
+/**
+Prints the hardware counters of every host phase to stdout
+
+@param results The execution results containing the counters
 */
-int main(int argc, char * argv[]);
+void printCounterResults(
+                  std::shared_ptr<bm_execution::ExecutionResults> results);
+
+/**
+Prints the GUOPS and error rates of every tenant and the fairness between
+the tenants to stdout
+
+@param results The execution results containing the tenant results
+*/
+void printTenantResults(
+                  std::shared_ptr<bm_execution::ExecutionResults> results);
+
+/**
+Prints the mean submission and finish times of the kernels of all
+replications to stdout
+
+@param results The execution results containing the launch results
+*/
+void printLaunchResults(
+                  std::shared_ptr<bm_execution::ExecutionResults> results);
+
 
 #endif // SRC_HOST_RANDOM_ACCESS_FUNCTIONALITY_H_
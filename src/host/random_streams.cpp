@@ -0,0 +1,215 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/random_streams.h"
+
+/* C++ standard library headers */
+#include <cstddef>
+
+/* External library headers */
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/random_access_definitions.h"
+
+namespace bm_random {
+
+/*
+ @copydoc bm_random::instructionSet()
+*/
+char const*
+instructionSet() {
+#if defined(__AVX512F__)
+    return "AVX-512";
+#elif defined(__AVX2__)
+    return "AVX2";
+#else
+    return "scalar";
+#endif
+}
+
+/*
+ @copydoc bm_random::seedStreams()
+*/
+void
+seedStreams(DATA_TYPE_UNSIGNED* states, DATA_TYPE_UNSIGNED first,
+            DATA_TYPE_UNSIGNED stride) {
+    for (int l = 0; l < RANDOM_STREAMS; l++) {
+        states[l] = starts(first + l * stride);
+    }
+}
+
+/*
+ @copydoc bm_random::advanceStreams()
+*/
+void
+advanceStreams(DATA_TYPE_UNSIGNED* states) {
+#if defined(__AVX512F__)
+    __m512i const poly = _mm512_set1_epi64(POLY);
+    for (int l = 0; l < RANDOM_STREAMS; l += 8) {
+        __m512i ran = _mm512_loadu_si512(states + l);
+        // The arithmetic shift creates a mask of all ones for negative values
+        __m512i v = _mm512_and_si512(_mm512_srai_epi64(ran, 63), poly);
+        ran = _mm512_xor_si512(_mm512_slli_epi64(ran, 1), v);
+        _mm512_storeu_si512(states + l, ran);
+    }
+#elif defined(__AVX2__)
+    __m256i const poly = _mm256_set1_epi64x(POLY);
+    __m256i const zero = _mm256_setzero_si256();
+    for (int l = 0; l < RANDOM_STREAMS; l += 4) {
+        __m256i ran = _mm256_loadu_si256(
+                                reinterpret_cast<__m256i*>(states + l));
+        __m256i v = _mm256_and_si256(_mm256_cmpgt_epi64(zero, ran), poly);
+        ran = _mm256_xor_si256(_mm256_slli_epi64(ran, 1), v);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(states + l), ran);
+    }
+#else
+    for (int l = 0; l < RANDOM_STREAMS; l++) {
+        DATA_TYPE v = 0;
+        if (((DATA_TYPE) states[l]) < 0) {
+            v = POLY;
+        }
+        states[l] = (states[l] << 1) ^ v;
+    }
+#endif
+}
+
+/*
+Applies a single update to all words of the entry with the given address
+*/
+static inline void
+updateEntry(DATA_TYPE_UNSIGNED* data, DATA_TYPE_UNSIGNED address,
+            DATA_TYPE_UNSIGNED ran, bool useXor, DATA_TYPE_UNSIGNED factor) {
+    DATA_TYPE_UNSIGNED* entry = data + address * ENTRY_WIDTH;
+    for (int w = 0; w < ENTRY_WIDTH; w++) {
+        if (useXor) {
+            entry[w] ^= ran;
+        } else {
+            entry[w] += factor * ran;
+        }
+    }
+}
+
+#if !defined(__AVX2__)
+/*
+Applies the updates of all streams to the data array without SIMD
+instructions. The operation is a template parameter, so the inner loop does
+not contain a branch for it.
+*/
+template<bool useXor>
+static void
+applyScalarUpdates(DATA_TYPE_UNSIGNED* data, DATA_TYPE_UNSIGNED mask,
+                   DATA_TYPE_UNSIGNED* states, size_t steps,
+                   DATA_TYPE_UNSIGNED factor) {
+    // Keep the states in registers while the updates are applied
+    DATA_TYPE_UNSIGNED ran[RANDOM_STREAMS];
+    for (int l = 0; l < RANDOM_STREAMS; l++) {
+        ran[l] = states[l];
+    }
+    for (size_t i = 0; i < steps; i++) {
+        for (int l = 0; l < RANDOM_STREAMS; l++) {
+            DATA_TYPE v = 0;
+            if (((DATA_TYPE) ran[l]) < 0) {
+                v = POLY;
+            }
+            ran[l] = (ran[l] << 1) ^ v;
+            updateEntry(data, ran[l] & mask, ran[l], useXor, factor);
+        }
+    }
+    for (int l = 0; l < RANDOM_STREAMS; l++) {
+        states[l] = ran[l];
+    }
+}
+#endif
+
+/*
+ @copydoc bm_random::applyUpdates()
+*/
+void
+applyUpdates(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+             bm_distribution::AddressMap const &addressOf,
+             DATA_TYPE_UNSIGNED* states, size_t steps, bool useXor,
+             DATA_TYPE_UNSIGNED factor) {
+    if (!addressOf.isUniform()) {
+        // The block table lookup can not be vectorized, so only the streams
+        // are advanced with SIMD instructions
+        for (size_t i = 0; i < steps; i++) {
+            advanceStreams(states);
+            for (int l = 0; l < RANDOM_STREAMS; l++) {
+                updateEntry(data, addressOf(states[l]), states[l], useXor,
+                            factor);
+            }
+        }
+        return;
+    }
+    DATA_TYPE_UNSIGNED const mask = dataSize - 1;
+#if defined(__AVX512F__) && defined(__AVX512CD__) && defined(__AVX512DQ__)\
+    && ENTRY_WIDTH == 1
+    // The gather and scatter instructions access a single word per lane
+    __m512i const addressMask = _mm512_set1_epi64(mask);
+    __m512i const factors = _mm512_set1_epi64(factor);
+    for (size_t i = 0; i < steps; i++) {
+        advanceStreams(states);
+        for (int l = 0; l < RANDOM_STREAMS; l += 8) {
+            __m512i ran = _mm512_loadu_si512(states + l);
+            __m512i address = _mm512_and_si512(ran, addressMask);
+            // Gather and scatter would lose updates if lanes share an address
+            __m512i conflicts = _mm512_conflict_epi64(address);
+            if (_mm512_test_epi64_mask(conflicts, conflicts) != 0) {
+                for (int k = l; k < l + 8; k++) {
+                    updateEntry(data, states[k] & mask, states[k], useXor,
+                                factor);
+                }
+                continue;
+            }
+            __m512i items = _mm512_i64gather_epi64(address, data, 8);
+            if (useXor) {
+                items = _mm512_xor_si512(items, ran);
+            } else {
+                items = _mm512_add_epi64(items,
+                                         _mm512_mullo_epi64(factors, ran));
+            }
+            _mm512_i64scatter_epi64(data, address, items, 8);
+        }
+    }
+#elif defined(__AVX2__)
+    // AVX2 has no scatter instruction, so only the streams are vectorized
+    for (size_t i = 0; i < steps; i++) {
+        advanceStreams(states);
+        for (int l = 0; l < RANDOM_STREAMS; l++) {
+            updateEntry(data, states[l] & mask, states[l], useXor, factor);
+        }
+    }
+#else
+    if (useXor) {
+        applyScalarUpdates<true>(data, mask, states, steps, factor);
+    } else {
+        applyScalarUpdates<false>(data, mask, states, steps, factor);
+    }
+#endif
+}
+
+}  // namespace bm_random
@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_RANDOM_STREAMS_H_
+#define SRC_HOST_RANDOM_STREAMS_H_
+
+/* C++ standard library headers */
+#include <cstddef>
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/random_access_definitions.h"
+
+/**
+Number of independent streams of random numbers that are advanced together.
+The streams are processed with AVX-512 or AVX2 instructions if the host code
+is compiled for a CPU that supports them (e.g. with CXX_FLAGS=-march=native).
+*/
+#define RANDOM_STREAMS 16
+
+namespace bm_random {
+
+/**
+Name of the instruction set used to advance the streams
+
+@return "AVX-512", "AVX2" or "scalar"
+*/
+char const*
+instructionSet();
+
+/**
+Seeds the streams with the jump-ahead of starts(). Stream l continues the
+update sequence after first + l * stride updates, so the streams together
+cover RANDOM_STREAMS * stride consecutive updates.
+
+@param states The states of the RANDOM_STREAMS streams
+@param first Number of updates before the first stream
+@param stride Number of updates covered by every stream
+*/
+void
+seedStreams(DATA_TYPE_UNSIGNED* states, DATA_TYPE_UNSIGNED first,
+            DATA_TYPE_UNSIGNED stride);
+
+/**
+Advances all streams by one update
+
+@param states The states of the RANDOM_STREAMS streams. They contain the
+        next random number of every stream afterwards.
+*/
+void
+advanceStreams(DATA_TYPE_UNSIGNED* states);
+
+/**
+Applies the given number of updates of every stream to the data array by
+adding factor times the random number to all words of the addressed entry.
+The updates of different streams are applied interleaved, so this can only
+be used for updates that commute like XOR or addition.
+
+@param data The data array
+@param dataSize Number of entries in the data array. Has to be a power of
+        two.
+@param addressOf The address map of the data array
+@param states The states of the RANDOM_STREAMS streams
+@param steps Number of updates of every stream
+@param useXor If true, the random numbers are XORed to the words and factor
+        is ignored
+@param factor Factor of the random numbers that are added to the items
+*/
+void
+applyUpdates(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+             bm_distribution::AddressMap const &addressOf,
+             DATA_TYPE_UNSIGNED* states, size_t steps, bool useXor,
+             DATA_TYPE_UNSIGNED factor);
+
+}  // namespace bm_random
+
+#endif  // SRC_HOST_RANDOM_STREAMS_H_
@@ -0,0 +1,170 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/regression_gate.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/fpga_setup.h"
+#include "src/host/random_access_definitions.h"
+#include "src/host/statistics.h"
+
+namespace bm_regression {
+
+/*
+Splits a line of a CSV file into its columns
+*/
+static std::vector<std::string>
+splitColumns(std::string const &line) {
+    std::vector<std::string> columns;
+    std::stringstream stream(line);
+    std::string column;
+    while (std::getline(stream, column, ',')) {
+        columns.push_back(column);
+    }
+    return columns;
+}
+
+/*
+ @copydoc bm_regression::loadBaseline()
+*/
+BaselineRow
+loadBaseline(std::string const &fileName, std::string const &key,
+             std::string const &board) {
+    std::ifstream file(fileName);
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line)) {
+        throw std::runtime_error("Could not read baseline file " + fileName);
+    }
+    std::map<std::string, size_t> header;
+    std::vector<std::string> names = splitColumns(line);
+    for (size_t i = 0; i < names.size(); i++) {
+        header[names[i]] = i;
+    }
+    for (char const* name : {"board", "best", "mean", "guops",
+                             "error"}) {
+        if (header.count(name) == 0) {
+            throw std::runtime_error("Baseline file " + fileName
+                                     + " has no column " + name);
+        }
+    }
+
+    while (std::getline(file, line)) {
+        std::vector<std::string> columns = splitColumns(line);
+        if (columns.size() != names.size() || columns[0] != key
+                || (!board.empty() && columns[header["board"]] != board)) {
+            continue;
+        }
+        return BaselineRow {columns[0], columns[header["board"]],
+                            std::stod(columns[header["best"]]),
+                            std::stod(columns[header["mean"]]),
+                            std::stod(columns[header["guops"]]),
+                            std::stod(columns[header["error"]])};
+    }
+    std::string row = key;
+    if (!board.empty()) {
+        row += " on board " + board;
+    }
+    throw std::runtime_error("No baseline for " + row + " in " + fileName);
+}
+
+/*
+ @copydoc bm_regression::compareToBaseline()
+*/
+bool
+compareToBaseline(std::shared_ptr<bm_execution::ExecutionResults> results,
+                  size_t dataSize, BaselineRow const &baseline,
+                  double maxDrop, double maxErrorIncrease) {
+    double updates = static_cast<double>(4 * dataSize) / 1000000000;
+    double tmin = std::numeric_limits<double>::max();
+    for (double time : results->times) {
+        tmin = std::min(tmin, time);
+    }
+    double guops = updates / tmin;
+    double error = 100.0 * results->errorRate;
+    double drop = 1.0 - guops / baseline.guops;
+
+    // Test if the kernel times are significantly longer than the time
+    // needed to reach the baseline GUOPS
+    std::vector<double> times = bm_statistics::rejectOutliers(results->times);
+    double t = bm_statistics::tStatistic(times, updates / baseline.guops);
+    bool significant = true;
+    if (times.size() > 1 && t != 0) {
+        significant = t > bm_statistics::tCritical95(times.size() - 1);
+    }
+
+    bool guopsRegression = drop > maxDrop && significant;
+    bool errorRegression = error - baseline.error > maxErrorIncrease;
+
+    std::cout << HLINE << "Baseline:            " << baseline.key << " ("
+              << baseline.board << ")" << std::endl;
+    std::cout << std::setw(ENTRY_SPACE) << " "
+              << std::setw(ENTRY_SPACE) << "baseline"
+              << std::setw(ENTRY_SPACE) << "current"
+              << std::setw(ENTRY_SPACE) << "change"
+              << std::setw(ENTRY_SPACE) << "limit" << std::endl;
+    std::cout << std::setw(ENTRY_SPACE) << "GUOPS"
+              << std::setw(ENTRY_SPACE) << baseline.guops
+              << std::setw(ENTRY_SPACE) << guops
+              << std::setw(ENTRY_SPACE) << -drop
+              << std::setw(ENTRY_SPACE) << -maxDrop << std::endl;
+    std::cout << std::setw(ENTRY_SPACE) << "error"
+              << std::setw(ENTRY_SPACE) << baseline.error
+              << std::setw(ENTRY_SPACE) << error
+              << std::setw(ENTRY_SPACE) << error - baseline.error
+              << std::setw(ENTRY_SPACE) << maxErrorIncrease << std::endl;
+    std::cout << "t-statistic:         " << t;
+    if (times.size() > 1) {
+        std::cout << " (critical value "
+                  << bm_statistics::tCritical95(times.size() - 1) << ")";
+    }
+    std::cout << std::endl;
+
+    if (guopsRegression) {
+        std::cout << "REGRESSION: GUOPS dropped by " << 100.0 * drop
+                  << "%" << std::endl;
+    }
+    if (errorRegression) {
+        std::cout << "REGRESSION: Error rate rose by "
+                  << error - baseline.error << " percent points" << std::endl;
+    }
+    if (!guopsRegression && !errorRegression) {
+        std::cout << "No regression detected" << std::endl;
+    }
+    return guopsRegression || errorRegression;
+}
+
+}  // namespace bm_regression
@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_REGRESSION_GATE_H_
+#define SRC_HOST_REGRESSION_GATE_H_
+
+/* C++ standard library headers */
+#include <memory>
+#include <string>
+
+/* Project's headers */
+#include "src/host/execution.h"
+
+/**
+Baseline file that is used if no other file is given
+*/
+#define DEFAULT_BASELINE_FILE "results/frandom_single_results.csv"
+
+namespace bm_regression {
+
+/**
+A row of a baseline file with the results of a previous run
+*/
+struct BaselineRow {
+    std::string key;
+    std::string board;
+    double best;
+    double mean;
+    double guops;
+    double error;
+};
+
+/**
+Loads a row from a baseline file in the format of the files in results/.
+The first column contains the key of the row. The columns board, best,
+mean, guops and error are found by their names in the header.
+Throws std::runtime_error if the file or the row can not be found.
+
+@param fileName The path to the baseline file
+@param key The key of the row, e.g. 19.1.0_single
+@param board If not empty, the board of the row has to match
+
+@return The baseline row
+*/
+BaselineRow
+loadBaseline(std::string const &fileName, std::string const &key,
+             std::string const &board);
+
+/**
+Compares the results of a run with a baseline and prints a report.
+A run is a regression if its GUOPS drop by more than maxDrop and the kernel
+times are significantly longer than the baseline time in a one-sided
+t-test, or if the error rate rises by more than maxErrorIncrease.
+
+@param results The results of the run
+@param dataSize Size of the data array in number of items
+@param baseline The baseline row
+@param maxDrop Maximum allowed relative drop of the GUOPS, e.g. 0.05
+@param maxErrorIncrease Maximum allowed increase of the error rate in
+        percent points like the error column of the baseline
+
+@return true, if the run is a regression
+*/
+bool
+compareToBaseline(std::shared_ptr<bm_execution::ExecutionResults> results,
+                  size_t dataSize, BaselineRow const &baseline,
+                  double maxDrop, double maxErrorIncrease);
+
+}  // namespace bm_regression
+
+#endif  // SRC_HOST_REGRESSION_GATE_H_
@@ -0,0 +1,112 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/repetition_control.h"
+
+/* C++ standard library headers */
+#include <memory>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/statistics.h"
+
+namespace bm_execution {
+
+RepetitionControl::RepetitionControl(
+                        std::shared_ptr<ExecutionConfiguration> config,
+                        double updatesPerExecution)
+        : config(config), updatesPerExecution(updatesPerExecution),
+          executions(0) {}
+
+/*
+ @copydoc bm_execution::RepetitionControl::next()
+*/
+bool
+RepetitionControl::next() {
+    if (executions < config->warmupRepetitions) {
+        return true;
+    }
+    if (config->soakDuration > 0) {
+        // Start the clock of the soak run after the warm-up
+        if (!soakMonitor) {
+            soakMonitor.reset(new SoakMonitor(config, updatesPerExecution));
+        }
+        return !soakMonitor->done();
+    }
+    if (times.size() < config->repetitions) {
+        return true;
+    }
+    if (config->targetRSE <= 0 || times.size() >= config->maxRepetitions) {
+        return false;
+    }
+    return bm_statistics::relativeStandardError(
+                bm_statistics::rejectOutliers(times)) > config->targetRSE;
+}
+
+/*
+ @copydoc bm_execution::RepetitionControl::initializeData()
+*/
+bool
+RepetitionControl::initializeData() const {
+    return config->soakDuration <= 0 || executions == 0;
+}
+
+/*
+ @copydoc bm_execution::RepetitionControl::addExecution()
+*/
+void
+RepetitionControl::addExecution(double kernelTime) {
+    if (executions >= config->warmupRepetitions) {
+        times.push_back(kernelTime);
+        if (soakMonitor) {
+            soakMonitor->addExecution(kernelTime);
+        }
+    }
+    executions++;
+    // The number of executions is only known for a fixed number of repetitions
+    size_t total = 0;
+    if (config->soakDuration <= 0 && config->targetRSE <= 0) {
+        total = config->warmupRepetitions + config->repetitions;
+    }
+    reportProgress(*config, "execute", executions, total);
+}
+
+/*
+ @copydoc bm_execution::RepetitionControl::finish()
+*/
+void
+RepetitionControl::finish() {
+    if (soakMonitor) {
+        soakMonitor->finish();
+    }
+}
+
+/*
+ @copydoc bm_execution::RepetitionControl::getTimes()
+*/
+std::vector<double>
+RepetitionControl::getTimes() const {
+    return times;
+}
+
+}  // namespace bm_execution
@@ -0,0 +1,106 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_REPETITION_CONTROL_H_
+#define SRC_HOST_REPETITION_CONTROL_H_
+
+/* C++ standard library headers */
+#include <memory>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/execution.h"
+#include "src/host/soak_monitor.h"
+
+namespace bm_execution {
+
+/**
+Decides how often the benchmark kernels are executed by the calculate call.
+Depending on the configuration this is
+    - a fixed number of repetitions,
+    - repetitions until the relative standard error of the kernel time drops
+      below a target or a maximum number of repetitions is reached,
+    - a soak run for a wall-clock duration.
+Warm-up executions are done before and are excluded from the measurements.
+
+@see bm_execution::ExecutionConfiguration
+*/
+class RepetitionControl {
+ public:
+    /**
+    @param config The configuration of the benchmark run
+    @param updatesPerExecution Number of updates done by a single execution
+                                of all kernel replications
+    */
+    RepetitionControl(std::shared_ptr<ExecutionConfiguration> config,
+                      double updatesPerExecution);
+
+    /**
+    Checks if another execution of the kernels has to be done
+
+    @return true, if the kernels should be executed again
+    */
+    bool
+    next();
+
+    /**
+    Checks if the data array has to be initialized on the host and written
+    to the device before the next execution. In a soak run this is only done
+    before the first execution. The following executions restore the initial
+    data on the device with bm_execution::restoreDataBuffers(), so every
+    execution starts from the initial data.
+
+    @return true, if the data has to be initialized
+    */
+    bool
+    initializeData() const;
+
+    /**
+    Adds the measured time of a kernel execution
+
+    @param kernelTime The execution time of the kernels in seconds
+    */
+    void
+    addExecution(double kernelTime);
+
+    /**
+    Finishes the run and prints the soak summary for soak runs
+    */
+    void
+    finish();
+
+    /**
+    @return the measured kernel times without the warm-up executions
+    */
+    std::vector<double>
+    getTimes() const;
+
+ private:
+    std::shared_ptr<ExecutionConfiguration> config;
+    double updatesPerExecution;
+    std::unique_ptr<SoakMonitor> soakMonitor;
+    uint executions;
+    std::vector<double> times;
+};
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_REPETITION_CONTROL_H_
@@ -0,0 +1,171 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/soak_monitor.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/fpga_setup.h"
+#include "src/host/random_access_definitions.h"
+
+/**
+Minimum number of kernel executions before the confidence interval is
+considered for stopping the soak run.
+*/
+#define SOAK_MIN_EXECUTIONS 5
+
+/**
+Quantile of the normal distribution used for the 95% confidence interval
+*/
+#define SOAK_Z_95 1.96
+
+namespace bm_execution {
+
+SoakMonitor::SoakMonitor(std::shared_ptr<ExecutionConfiguration> config,
+                         double updatesPerExecution)
+        : config(config), updatesPerExecution(updatesPerExecution),
+          intervalKernelTime(0), intervalExecutions(0), executions(0),
+          gupsMean(0), gupsM2(0) {
+    startTime = std::chrono::high_resolution_clock::now();
+    intervalStart = startTime;
+    std::cout << HLINE << "Soak run for " << config->soakDuration << "s"
+              << std::endl
+              << std::setw(ENTRY_SPACE) << "timestamp"
+              << std::setw(ENTRY_SPACE) << "elapsed"
+              << std::setw(ENTRY_SPACE) << "executions"
+              << std::setw(ENTRY_SPACE) << "GUOPS" << std::endl;
+}
+
+/*
+ @copydoc bm_execution::SoakMonitor::addExecution()
+*/
+void
+SoakMonitor::addExecution(double kernelTime) {
+    intervalKernelTime += kernelTime;
+    intervalExecutions++;
+
+    // Welford's online algorithm for the variance of the throughput
+    double gups = updatesPerExecution / kernelTime / 1.0e9;
+    executions++;
+    double delta = gups - gupsMean;
+    gupsMean += delta / executions;
+    gupsM2 += delta * (gups - gupsMean);
+
+    std::chrono::duration<double> intervalTime =
+            std::chrono::high_resolution_clock::now() - intervalStart;
+    if (intervalTime.count() >= config->soakInterval) {
+        printSample();
+    }
+}
+
+/*
+ @copydoc bm_execution::SoakMonitor::done()
+*/
+bool
+SoakMonitor::done() const {
+    std::chrono::duration<double> elapsed =
+            std::chrono::high_resolution_clock::now() - startTime;
+    if (elapsed.count() >= config->soakDuration) {
+        return true;
+    }
+    if (config->soakConfidence > 0 && executions >= SOAK_MIN_EXECUTIONS) {
+        double stddev = std::sqrt(gupsM2 / (executions - 1));
+        double halfWidth = SOAK_Z_95 * stddev / std::sqrt(executions);
+        return halfWidth / gupsMean <= config->soakConfidence;
+    }
+    return false;
+}
+
+/*
+ @copydoc bm_execution::SoakMonitor::finish()
+*/
+void
+SoakMonitor::finish() {
+    if (intervalExecutions > 0) {
+        printSample();
+    }
+    std::chrono::duration<double> elapsed =
+            std::chrono::high_resolution_clock::now() - startTime;
+    std::cout << HLINE << "Soak summary:" << std::endl
+              << "Duration:            " << elapsed.count() << "s"
+              << std::endl
+              << "Executions:          " << executions << std::endl;
+    if (sampleGups.empty()) {
+        std::cout << HLINE;
+        return;
+    }
+    double stddev = (executions > 1) ?
+                        std::sqrt(gupsM2 / (executions - 1)) : 0.0;
+    std::cout << "Mean GUOPS:          " << gupsMean << std::endl
+              << "95% CI half width:   "
+              << SOAK_Z_95 * stddev / std::sqrt(executions) << std::endl
+              << "Min interval GUOPS:  "
+              << *std::min_element(sampleGups.begin(), sampleGups.end())
+              << std::endl
+              << "Max interval GUOPS:  "
+              << *std::max_element(sampleGups.begin(), sampleGups.end())
+              << std::endl
+              << "Drift first to last: "
+              << 100.0 * (sampleGups.back() - sampleGups.front())
+                                                    / sampleGups.front()
+              << "%" << std::endl << HLINE;
+}
+
+/*
+Prints the throughput of the current interval and starts a new interval
+*/
+void
+SoakMonitor::printSample() {
+    auto now = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = now - startTime;
+    std::chrono::duration<double> timestamp =
+            std::chrono::system_clock::now().time_since_epoch();
+    double gups = updatesPerExecution * intervalExecutions
+                    / intervalKernelTime / 1.0e9;
+    sampleGups.push_back(gups);
+
+    // Format the sample locally to keep the formatting of std::cout
+    std::stringstream sample;
+    sample << std::setw(ENTRY_SPACE) << std::fixed << std::setprecision(1)
+           << timestamp.count()
+           << std::setw(ENTRY_SPACE) << elapsed.count()
+           << std::setw(ENTRY_SPACE) << intervalExecutions
+           << std::scientific << std::setprecision(5)
+           << std::setw(ENTRY_SPACE) << gups;
+    std::cout << sample.str() << std::endl;
+
+    intervalKernelTime = 0;
+    intervalExecutions = 0;
+    intervalStart = now;
+}
+
+}  // namespace bm_execution
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_SOAK_MONITOR_H_
+#define SRC_HOST_SOAK_MONITOR_H_
+
+/* C++ standard library headers */
+#include <chrono>
+#include <memory>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/execution.h"
+
+namespace bm_execution {
+
+/**
+Keeps track of the kernel executions of a soak run.
+The executions are grouped into intervals of at least
+ExecutionConfiguration::soakInterval seconds and the throughput of every
+interval is printed as a timestamped line to stdout, so drift and throttling
+over the run become visible.
+
+@see bm_execution::ExecutionConfiguration
+*/
+class SoakMonitor {
+ public:
+    /**
+    Creates the monitor and starts the wall clock of the soak run.
+    Prints the header of the sample table.
+
+    @param config The configuration containing the soak settings
+    @param updatesPerExecution Number of updates done by a single execution
+                                of all kernel replications
+    */
+    SoakMonitor(std::shared_ptr<ExecutionConfiguration> config,
+                double updatesPerExecution);
+
+    /**
+    Adds the measured time of a kernel execution and prints a sample if the
+    current interval is complete.
+
+    @param kernelTime The execution time of the kernels in seconds
+    */
+    void
+    addExecution(double kernelTime);
+
+    /**
+    Checks if the soak run is finished. This is the case if the duration
+    is exceeded or the confidence interval of the throughput converged.
+
+    @return true, if no more executions should be started
+    */
+    bool
+    done() const;
+
+    /**
+    Prints the last incomplete interval and a summary of the throughput
+    samples to stdout.
+    */
+    void
+    finish();
+
+ private:
+    void
+    printSample();
+
+    std::shared_ptr<ExecutionConfiguration> config;
+    double updatesPerExecution;
+    std::chrono::high_resolution_clock::time_point startTime;
+    std::chrono::high_resolution_clock::time_point intervalStart;
+
+    // Accumulated kernel time and executions of the current interval
+    double intervalKernelTime;
+    uint intervalExecutions;
+
+    // Running mean and variance of the GUOPS of single executions
+    uint executions;
+    double gupsMean;
+    double gupsM2;
+
+    std::vector<double> sampleGups;
+};
+
+}  // namespace bm_execution
+
+#endif  // SRC_HOST_SOAK_MONITOR_H_
@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/statistics.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace bm_statistics {
+
+/*
+ @copydoc bm_statistics::mean()
+*/
+double
+mean(std::vector<double> const &values) {
+    double sum = 0;
+    for (double v : values) {
+        sum += v;
+    }
+    return sum / values.size();
+}
+
+/*
+ @copydoc bm_statistics::standardDeviation()
+*/
+double
+standardDeviation(std::vector<double> const &values) {
+    if (values.size() < 2) {
+        return 0;
+    }
+    double m = mean(values);
+    double sum = 0;
+    for (double v : values) {
+        sum += (v - m) * (v - m);
+    }
+    return std::sqrt(sum / (values.size() - 1));
+}
+
+/*
+ @copydoc bm_statistics::relativeStandardError()
+*/
+double
+relativeStandardError(std::vector<double> const &values) {
+    if (values.size() < 2) {
+        return 0;
+    }
+    return standardDeviation(values) / std::sqrt(values.size())
+                / mean(values);
+}
+
+/*
+ @copydoc bm_statistics::median()
+*/
+double
+median(std::vector<double> values) {
+    size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    double m = values[middle];
+    if (values.size() % 2 == 0) {
+        m = (m + *std::max_element(values.begin(),
+                                   values.begin() + middle)) / 2;
+    }
+    return m;
+}
+
+/*
+ @copydoc bm_statistics::medianAbsoluteDeviation()
+*/
+double
+medianAbsoluteDeviation(std::vector<double> const &values) {
+    double m = median(values);
+    std::vector<double> deviations;
+    for (double v : values) {
+        deviations.push_back(std::abs(v - m));
+    }
+    return median(deviations);
+}
+
+/*
+ @copydoc bm_statistics::rejectOutliers()
+*/
+std::vector<double>
+rejectOutliers(std::vector<double> const &values) {
+    if (values.empty()) {
+        return values;
+    }
+    double m = median(values);
+    double limit = OUTLIER_THRESHOLD * MAD_SCALE
+                        * medianAbsoluteDeviation(values);
+    if (limit == 0) {
+        return values;
+    }
+    std::vector<double> filtered;
+    for (double v : values) {
+        if (std::abs(v - m) <= limit) {
+            filtered.push_back(v);
+        }
+    }
+    return filtered;
+}
+
+/*
+ @copydoc bm_statistics::tStatistic()
+*/
+double
+tStatistic(std::vector<double> const &values, double reference) {
+    double deviation = standardDeviation(values);
+    if (deviation == 0) {
+        return 0;
+    }
+    return (mean(values) - reference) / (deviation / std::sqrt(values.size()));
+}
+
+/*
+ @copydoc bm_statistics::tCritical95()
+*/
+double
+tCritical95(size_t degreesOfFreedom) {
+    static const double critical[] = {6.314, 2.920, 2.353, 2.132, 2.015,
+                                      1.943, 1.895, 1.860, 1.833, 1.812,
+                                      1.796, 1.782, 1.771, 1.761, 1.753,
+                                      1.746, 1.740, 1.734, 1.729, 1.725,
+                                      1.721, 1.717, 1.714, 1.711, 1.708,
+                                      1.706, 1.703, 1.701, 1.699, 1.697};
+    if (degreesOfFreedom > 30) {
+        return 1.645;
+    }
+    return critical[degreesOfFreedom - 1];
+}
+
+}  // namespace bm_statistics
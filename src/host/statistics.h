@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_STATISTICS_H_
+#define SRC_HOST_STATISTICS_H_
+
+/* C++ standard library headers */
+#include <cstddef>
+#include <vector>
+
+/**
+Factor used to scale the median absolute deviation to an estimate of the
+standard deviation for normally distributed measurements
+*/
+#define MAD_SCALE 1.4826
+
+/**
+Measurements that deviate more than this number of scaled median absolute
+deviations from the median are rejected as outliers
+*/
+#ifndef OUTLIER_THRESHOLD
+#define OUTLIER_THRESHOLD 3.0
+#endif
+
+/**
+Contains helper functions to calculate statistics over the measured
+execution times.
+*/
+namespace bm_statistics {
+
+/**
+Calculates the arithmetic mean of the given values
+
+@param values The values. Must not be empty.
+@return the mean of the values
+*/
+double
+mean(std::vector<double> const &values);
+
+/**
+Calculates the sample standard deviation of the given values
+
+@param values The values
+@return the standard deviation or 0 if less than two values are given
+*/
+double
+standardDeviation(std::vector<double> const &values);
+
+/**
+Calculates the relative standard error of the mean of the given values
+
+@param values The values
+@return the standard error of the mean divided by the mean or 0 if less than
+        two values are given
+*/
+double
+relativeStandardError(std::vector<double> const &values);
+
+/**
+Calculates the median of the given values
+
+@param values The values. Must not be empty.
+@return the median of the values
+*/
+double
+median(std::vector<double> values);
+
+/**
+Calculates the median absolute deviation of the given values
+
+@param values The values. Must not be empty.
+@return the median of the absolute deviations from the median
+*/
+double
+medianAbsoluteDeviation(std::vector<double> const &values);
+
+/**
+Removes outliers from the given values. A value is an outlier if it deviates
+more than OUTLIER_THRESHOLD scaled median absolute deviations from the
+median. Nothing is removed if the median absolute deviation is zero.
+
+@param values The values
+@return the values without the outliers in their original order
+*/
+std::vector<double>
+rejectOutliers(std::vector<double> const &values);
+
+/**
+Calculates the t-statistic of a one-sample Student's t-test that compares
+the mean of the given values with a reference value
+
+@param values The values
+@param reference The reference value, e.g. the mean of a baseline
+@return the t-statistic or 0 if less than two values are given or the
+        values do not vary
+*/
+double
+tStatistic(std::vector<double> const &values, double reference);
+
+/**
+Returns the critical value of a one-sided Student's t-test with a
+significance level of 5%
+
+@param degreesOfFreedom The degrees of freedom of the test. Must be > 0.
+@return the critical value. The normal approximation is used for more than
+        30 degrees of freedom.
+*/
+double
+tCritical95(size_t degreesOfFreedom);
+
+}  // namespace bm_statistics
+
+#endif  // SRC_HOST_STATISTICS_H_
@@ -0,0 +1,215 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/trace.h"
+
+/* C++ standard library headers */
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+namespace bm_trace {
+
+/*
+A single complete event of the trace
+*/
+struct TraceEvent {
+    std::string name;
+    double start;
+    double duration;
+    int tid;
+    std::string args;
+};
+
+static bool enabled = false;
+static thread_local bool recording = true;
+static std::string traceFileName;
+static std::chrono::high_resolution_clock::time_point traceStart;
+static std::vector<TraceEvent> events;
+static std::mutex eventsMutex;
+
+/*
+ @copydoc bm_trace::enable()
+*/
+void
+enable(std::string const &fileName) {
+    traceFileName = fileName;
+    traceStart = std::chrono::high_resolution_clock::now();
+    enabled = true;
+}
+
+/*
+ @copydoc bm_trace::isEnabled()
+*/
+bool
+isEnabled() {
+    return enabled && recording;
+}
+
+/*
+ @copydoc bm_trace::now()
+*/
+double
+now() {
+    std::chrono::duration<double, std::micro> t =
+            std::chrono::high_resolution_clock::now() - traceStart;
+    return t.count();
+}
+
+/*
+ @copydoc bm_trace::queueProperties()
+*/
+cl_command_queue_properties
+queueProperties() {
+    return isEnabled() ? CL_QUEUE_PROFILING_ENABLE : 0;
+}
+
+/*
+ @copydoc bm_trace::addEvent()
+*/
+void
+addEvent(std::string const &name, double start, double duration, int tid,
+         std::string const &args) {
+    if (!isEnabled()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    events.push_back(TraceEvent{name, start, duration, tid, args});
+}
+
+/*
+ @copydoc bm_trace::addCLEvent()
+*/
+void
+addCLEvent(std::string const &name, cl::Event const &event, int queue,
+           double enqueueTime) {
+    if (!isEnabled()) {
+        return;
+    }
+    // Device timestamps are given in nanoseconds
+    double queued = event.getProfilingInfo<CL_PROFILING_COMMAND_QUEUED>()
+                        / 1000.0;
+    double start = event.getProfilingInfo<CL_PROFILING_COMMAND_START>()
+                        / 1000.0;
+    double end = event.getProfilingInfo<CL_PROFILING_COMMAND_END>()
+                        / 1000.0;
+    addEvent(name, enqueueTime + (start - queued), end - start, queue + 1);
+}
+
+/*
+Escapes the quotes, backslashes and control characters of a string, so it can
+be written as a JSON string, e.g. the name of a kernel file
+*/
+static std::string
+escapeJSON(std::string const &text) {
+    std::stringstream escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped << "\\u" << std::hex << std::setw(4)
+                    << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+            escaped << c;
+        }
+    }
+    return escaped.str();
+}
+
+/*
+ @copydoc bm_trace::write()
+*/
+void
+write() {
+    if (!enabled) {
+        return;
+    }
+    std::ofstream traceFile(traceFileName);
+    if (!traceFile.is_open()) {
+        std::cerr << "Not possible to open trace file " << traceFileName
+                  << std::endl;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    traceFile << std::fixed << std::setprecision(3)
+              << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+    std::set<int> tids;
+    for (TraceEvent const &e : events) {
+        tids.insert(e.tid);
+        traceFile << "{\"name\":\"" << escapeJSON(e.name)
+                  << "\",\"ph\":\"X\",\"pid\":0,"
+                  << "\"tid\":" << e.tid << ",\"ts\":" << e.start
+                  << ",\"dur\":" << e.duration;
+        if (!e.args.empty()) {
+            traceFile << ",\"args\":{" << e.args << "}";
+        }
+        traceFile << "}," << std::endl;
+    }
+    // Name the host thread and the command queues
+    for (int tid : tids) {
+        std::string threadName = (tid == TRACE_HOST_TID) ? "host" :
+                                    "queue " + std::to_string(tid - 1);
+        traceFile << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+                  << "\"tid\":" << tid << ",\"args\":{\"name\":\""
+                  << escapeJSON(threadName) << "\"}}," << std::endl;
+    }
+    traceFile << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+              << "\"args\":{\"name\":\"random access benchmark\"}}"
+              << std::endl << "]}" << std::endl;
+    std::cout << "Trace written to " << traceFileName << std::endl;
+}
+
+ScopedRecording::ScopedRecording(bool record)
+        : previous(recording) {
+    recording = record;
+}
+
+ScopedRecording::~ScopedRecording() {
+    recording = previous;
+}
+
+ScopedTrace::ScopedTrace(char const *name)
+        : name(name), start(0), counters(name) {
+    if (isEnabled()) {
+        start = now();
+    }
+}
+
+ScopedTrace::~ScopedTrace() {
+    std::vector<int64_t> values = counters.stop();
+    if (isEnabled()) {
+        addEvent(name, start, now() - start, TRACE_HOST_TID,
+                 bm_perf::toJSON(values));
+    }
+}
+
+}  // namespace bm_trace
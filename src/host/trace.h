@@ -0,0 +1,156 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_TRACE_H_
+#define SRC_HOST_TRACE_H_
+
+/* C++ standard library headers */
+#include <string>
+
+/* External library headers */
+#include "CL/cl.hpp"
+
+/* Project's headers */
+#include "src/host/perf_counters.h"
+
+/**
+Makro that creates a scoped timer for the current block.
+The duration of the block is added to the trace if tracing is enabled and the
+hardware counters of the block are measured if they are enabled.
+*/
+#define TRACE_SCOPE_CONCAT_EXPAND(a, b) a ## b
+#define TRACE_SCOPE_CONCAT(a, b) TRACE_SCOPE_CONCAT_EXPAND(a, b)
+#define TRACE_SCOPE(name) bm_trace::ScopedTrace \
+                            TRACE_SCOPE_CONCAT(trace_scope_, __LINE__)(name)
+
+/**
+Thread id used in the trace for all phases executed by the host
+*/
+#define TRACE_HOST_TID 0
+
+/**
+Records the phases of a benchmark run and writes them to a file in the
+Chrome trace event format. The file can be viewed in chrome://tracing or
+Perfetto. As long as tracing is not enabled, all calls return immediately.
+The recording can be switched off per thread, e.g. for a single run.
+*/
+namespace bm_trace {
+
+/**
+Enables tracing for the rest of the program run
+
+@param fileName Path to the trace file that is written by write()
+*/
+void
+enable(std::string const &fileName);
+
+/**
+@return true, if tracing is enabled and the calling thread records its
+        events
+*/
+bool
+isEnabled();
+
+/**
+@return the time in microseconds since tracing was enabled
+*/
+double
+now();
+
+/**
+Returns the properties that have to be used to create command queues.
+Profiling is only enabled for the queues if tracing is enabled, so the
+timestamps of the OpenCL events can be added to the trace.
+
+@return CL_QUEUE_PROFILING_ENABLE if tracing is enabled, 0 otherwise
+*/
+cl_command_queue_properties
+queueProperties();
+
+/**
+Adds a complete event to the trace
+
+@param name The name of the event
+@param start Start of the event in microseconds as returned by now()
+@param duration Duration of the event in microseconds
+@param tid Thread id of the event. Use TRACE_HOST_TID for host phases or the
+            index of the command queue + 1 for device commands.
+@param args Optional members of a JSON object that are added as arguments of
+            the event, e.g. the hardware counters of a host phase
+*/
+void
+addEvent(std::string const &name, double start, double duration, int tid,
+         std::string const &args = "");
+
+/**
+Adds the execution of a finished OpenCL command to the trace.
+The device timestamps of the event are aligned to the host clock using the
+time the command was enqueued.
+
+@param name The name of the event
+@param event The event of the finished command. The command queue must
+            have been created with queueProperties().
+@param queue Index of the command queue the command was enqueued in
+@param enqueueTime Host time returned by now() just before the command was
+            enqueued
+*/
+void
+addCLEvent(std::string const &name, cl::Event const &event, int queue,
+           double enqueueTime);
+
+/**
+Writes all recorded events to the trace file given to enable()
+*/
+void
+write();
+
+/**
+Switches the recording of the events of the calling thread on or off until
+it is destroyed. Threads record their events by default.
+*/
+class ScopedRecording {
+ public:
+    explicit ScopedRecording(bool record);
+    ~ScopedRecording();
+
+ private:
+    bool previous;
+};
+
+/**
+Measures the time between its construction and destruction and adds it as
+event to the trace. The hardware counters of the scope are added as
+arguments of the event.
+*/
+class ScopedTrace {
+ public:
+    explicit ScopedTrace(char const *name);
+    ~ScopedTrace();
+
+ private:
+    char const *name;
+    double start;
+    bm_perf::ScopedCounters counters;
+};
+
+}  // namespace bm_trace
+
+#endif  // SRC_HOST_TRACE_H_
@@ -0,0 +1,352 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* Related header files */
+#include "src/host/verification.h"
+
+/* C++ standard library headers */
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/random_access_definitions.h"
+#include "src/host/random_streams.h"
+#include "src/host/trace.h"
+
+namespace bm_verification {
+
+/*
+Calculates the next pseudo random number of the update sequence
+*/
+static inline DATA_TYPE_UNSIGNED
+nextRandom(DATA_TYPE_UNSIGNED ran) {
+    DATA_TYPE v = 0;
+    if (((DATA_TYPE)ran) < 0) {
+        v = POLY;
+    }
+    return (ran << 1) ^ v;
+}
+
+/*
+Replays all updates of a kernel execution that starts after the given number
+of updates of the sequence. The updates commute, so they are split into
+multiple streams that are processed together. If the number of updates can
+not be split, a single stream is used.
+*/
+static void
+replayCommutingUpdates(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+                       bm_distribution::AddressMap const &addressOf,
+                       bool useXor, DATA_TYPE_UNSIGNED factor,
+                       DATA_TYPE_UNSIGNED first) {
+    TRACE_SCOPE("replay updates");
+    DATA_TYPE_UNSIGNED updates = 4L*dataSize;
+    if (updates % RANDOM_STREAMS == 0) {
+        DATA_TYPE_UNSIGNED states[RANDOM_STREAMS];
+        bm_random::seedStreams(states, first, updates / RANDOM_STREAMS);
+        bm_random::applyUpdates(data, dataSize, addressOf, states,
+                                updates / RANDOM_STREAMS, useXor, factor);
+        return;
+    }
+    DATA_TYPE_UNSIGNED temp = starts(first);
+    for (DATA_TYPE_UNSIGNED i=0; i < updates; i++) {
+        temp = nextRandom(temp);
+        DATA_TYPE_UNSIGNED* entry = data + addressOf(temp) * ENTRY_WIDTH;
+        for (int w=0; w < ENTRY_WIDTH; w++) {
+            if (useXor) {
+                entry[w] ^= temp;
+            } else {
+                entry[w] += factor * temp;
+            }
+        }
+    }
+}
+
+/*
+Reverts the additions of the given number of kernel executions
+*/
+static void
+revertAdditions(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+                bm_distribution::AddressMap const &addressOf,
+                size_t executions, DATA_TYPE_UNSIGNED first) {
+    replayCommutingUpdates(data, dataSize, addressOf, false,
+                           -static_cast<DATA_TYPE_UNSIGNED>(executions),
+                           first);
+}
+
+/*
+Counts a wrong entry in its chunk and its region of the error map
+*/
+static inline void
+mapError(bm_execution::ErrorMap* errorMap, size_t entry, size_t dataSize) {
+    size_t const chunks = errorMap->chunkErrors.size();
+    size_t const regions = errorMap->regionErrors.size();
+    // The last chunk also contains the remainder of the data array
+    errorMap->chunkErrors[std::min(entry / (dataSize / chunks),
+                                   chunks - 1)]++;
+    errorMap->regionErrors[std::min(entry / (dataSize / regions),
+                                    regions - 1)]++;
+}
+
+/*
+Counts the entries that differ from the expected entries in at least one word.
+If no expected entries are given, every word has to contain its own index.
+*/
+static size_t
+countEntryErrors(DATA_TYPE_UNSIGNED const* data,
+                 DATA_TYPE_UNSIGNED const* expected, size_t dataSize,
+                 bm_execution::ErrorMap* errorMap) {
+    TRACE_SCOPE("count errors");
+    size_t errors = 0;
+    for (size_t i=0; i < dataSize; i++) {
+        for (int w=0; w < ENTRY_WIDTH; w++) {
+            DATA_TYPE_UNSIGNED const word = i * ENTRY_WIDTH + w;
+            if (data[word] != (expected == nullptr ? word : expected[word])) {
+                errors++;
+                if (errorMap != nullptr) {
+                    mapError(errorMap, i, dataSize);
+                }
+                break;
+            }
+        }
+    }
+    return errors;
+}
+
+/*
+Counts the wrong entries after write only updates. The expected data array is
+calculated by replaying the writes. If firstWriteWins is set, only the first
+write to an entry is kept like for OPERATION_CAS.
+*/
+static size_t
+countWriteErrors(DATA_TYPE_UNSIGNED const* data, size_t dataSize,
+                 bm_distribution::AddressMap const &addressOf,
+                 bool firstWriteWins, DATA_TYPE_UNSIGNED first,
+                 bm_execution::ErrorMap* errorMap) {
+    DATA_TYPE_UNSIGNED* expected;
+    posix_memalign(reinterpret_cast<void **>(&expected), 64,
+                   ENTRY_SIZE * dataSize);
+    initializeData(expected, dataSize, 0);
+    {
+        TRACE_SCOPE("replay updates");
+        DATA_TYPE_UNSIGNED temp = starts(first);
+        for (DATA_TYPE_UNSIGNED i=0; i < 4L*dataSize; i++) {
+            temp = nextRandom(temp);
+            DATA_TYPE_UNSIGNED word = addressOf(temp) * ENTRY_WIDTH;
+            // CAS compares the first word with its initial value
+            if (!firstWriteWins || expected[word] == word) {
+                for (int w=0; w < ENTRY_WIDTH; w++) {
+                    expected[word + w] = temp;
+                }
+            }
+        }
+    }
+    size_t errors = countEntryErrors(data, expected, dataSize, errorMap);
+    free(reinterpret_cast<void *>(expected));
+    return errors;
+}
+
+/*
+ @copydoc bm_verification::initializeData()
+*/
+void
+initializeData(DATA_TYPE_UNSIGNED* data, size_t size, size_t offset) {
+    TRACE_SCOPE("initialize data");
+    // Every word contains its own index in the data array
+    DATA_TYPE_UNSIGNED const firstWord = offset * ENTRY_WIDTH;
+    for (DATA_TYPE_UNSIGNED j=0; j < size * ENTRY_WIDTH; j++) {
+        data[j] = firstWord + j;
+    }
+}
+
+/*
+ @copydoc bm_verification::mergeChunks()
+*/
+void
+mergeChunks(std::vector<DATA_TYPE_UNSIGNED*> const &chunks,
+            DATA_TYPE_UNSIGNED* data, size_t dataSize) {
+    TRACE_SCOPE("merge chunks");
+    size_t chunkSize = dataSize / chunks.size() * ENTRY_WIDTH;
+    for (size_t r =0; r < chunks.size(); r++) {
+        for (size_t j=0; j < chunkSize; j++) {
+            data[r*chunkSize + j] = chunks[r][j];
+        }
+    }
+}
+
+/*
+ @copydoc bm_verification::replayUpdates()
+*/
+void
+replayUpdates(DATA_TYPE_UNSIGNED* data, size_t dataSize) {
+    std::vector<cl_uint> const uniform;
+    replayCommutingUpdates(data, dataSize,
+                           bm_distribution::AddressMap(dataSize, uniform),
+                           true, 1, 0);
+}
+
+/*
+ @copydoc bm_verification::countErrors()
+*/
+size_t
+countErrors(DATA_TYPE_UNSIGNED const* data, size_t dataSize) {
+    return countEntryErrors(data, nullptr, dataSize, nullptr);
+}
+
+/*
+Verifies the data array after the updates that start after the given number
+of updates of the sequence. The wrong entries are also counted in the error
+map if it is given.
+*/
+static size_t
+verifyUpdates(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+              bm_distribution::AddressMap const &addressOf, int operation,
+              size_t executions, DATA_TYPE_UNSIGNED first,
+              bm_execution::ErrorMap* errorMap) {
+    switch (operation) {
+        case OPERATION_ADD:
+            revertAdditions(data, dataSize, addressOf, executions, first);
+            break;
+        case OPERATION_SCATTER:
+        case OPERATION_CAS:
+            // Repeated writes of the same values do not change the result
+            if (executions > 0) {
+                return countWriteErrors(data, dataSize, addressOf,
+                                        operation == OPERATION_CAS, first,
+                                        errorMap);
+            }
+            break;
+        case OPERATION_GATHER:
+            // The data is only read and has to be unchanged
+            break;
+        default:
+            // The XOR updates are their own inverse, so after an even
+            // number of executions the data is in its initial state
+            if (executions % 2 == 1) {
+                replayCommutingUpdates(data, dataSize, addressOf, true, 1,
+                                       first);
+            }
+    }
+    return countEntryErrors(data, nullptr, dataSize, errorMap);
+}
+
+/*
+ @copydoc bm_verification::verifyData()
+*/
+size_t
+verifyData(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+           std::vector<cl_uint> const &blockTable, int operation,
+           size_t executions, bm_execution::ErrorMap* errorMap) {
+    return verifyUpdates(data, dataSize,
+                         bm_distribution::AddressMap(dataSize, blockTable),
+                         operation, executions, 0, errorMap);
+}
+
+/*
+ @copydoc bm_verification::verifyTenantData()
+*/
+size_t
+verifyTenantData(DATA_TYPE_UNSIGNED* data, size_t dataSize, int operation,
+                 size_t executions, DATA_TYPE_UNSIGNED first) {
+    std::vector<cl_uint> const uniform;
+    return verifyUpdates(data, dataSize,
+                         bm_distribution::AddressMap(dataSize, uniform),
+                         operation, executions, first, nullptr);
+}
+
+/*
+Calculates the checksums of the chunks of all replications for the updates
+that start after the given number of updates of the sequence
+*/
+static std::vector<DATA_TYPE_UNSIGNED>
+accumulateChecksums(size_t dataSize,
+                    bm_distribution::AddressMap const &addressOf,
+                    size_t replications, DATA_TYPE_UNSIGNED first) {
+    TRACE_SCOPE("calculate checksums");
+    size_t chunkSize = dataSize / replications;
+    std::vector<DATA_TYPE_UNSIGNED> checksums(replications, 0);
+    DATA_TYPE_UNSIGNED temp = starts(first);
+    for (DATA_TYPE_UNSIGNED i=0; i < 4L*dataSize; i++) {
+        temp = nextRandom(temp);
+        // Every word contains its own index and the words of all loaded
+        // entries are accumulated. Like in the kernels, the remainder of
+        // the data array behind the last chunk is never loaded.
+        DATA_TYPE_UNSIGNED address = addressOf(temp);
+        if (address >= replications * chunkSize) {
+            continue;
+        }
+        for (int w=0; w < ENTRY_WIDTH; w++) {
+            checksums[address / chunkSize] ^= address * ENTRY_WIDTH + w;
+        }
+    }
+    return checksums;
+}
+
+/*
+ @copydoc bm_verification::calculateChecksums()
+*/
+std::vector<DATA_TYPE_UNSIGNED>
+calculateChecksums(size_t dataSize, std::vector<cl_uint> const &blockTable,
+                   size_t replications) {
+    return accumulateChecksums(dataSize,
+                            bm_distribution::AddressMap(dataSize, blockTable),
+                            replications, 0);
+}
+
+/*
+ @copydoc bm_verification::calculateTenantChecksum()
+*/
+DATA_TYPE_UNSIGNED
+calculateTenantChecksum(size_t dataSize, DATA_TYPE_UNSIGNED first) {
+    std::vector<cl_uint> const uniform;
+    return accumulateChecksums(dataSize,
+                               bm_distribution::AddressMap(dataSize, uniform),
+                               1, first)[0];
+}
+
+/*
+ @copydoc bm_verification::countChecksumErrors()
+*/
+size_t
+countChecksumErrors(std::vector<DATA_TYPE_UNSIGNED> const &checksums,
+                    size_t dataSize, std::vector<cl_uint> const &blockTable,
+                    bm_execution::ErrorMap* errorMap) {
+    std::vector<DATA_TYPE_UNSIGNED> expected =
+                calculateChecksums(dataSize, blockTable, checksums.size());
+    size_t const chunkSize = dataSize / checksums.size();
+    size_t errors = 0;
+    for (size_t r = 0; r < checksums.size(); r++) {
+        if (checksums[r] != expected[r]) {
+            errors += chunkSize;
+            if (errorMap == nullptr) {
+                continue;
+            }
+            for (size_t i = r * chunkSize; i < (r + 1) * chunkSize; i++) {
+                mapError(errorMap, i, dataSize);
+            }
+        }
+    }
+    return errors;
+}
+
+}  // namespace bm_verification
@@ -0,0 +1,179 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef SRC_HOST_VERIFICATION_H_
+#define SRC_HOST_VERIFICATION_H_
+
+/* C++ standard library headers */
+#include <vector>
+
+/* Project's headers */
+#include "src/host/execution.h"
+#include "src/host/random_access_definitions.h"
+
+/**
+Contains the functions used by all implementations to prepare the data array
+on the host and to verify it after the updates on the device.
+*/
+namespace bm_verification {
+
+/**
+Initializes a part of the data array with the index of each word.
+Word w of entry a contains a * ENTRY_WIDTH + w.
+
+@param data The part of the data array that is initialized
+@param size Number of entries in the part
+@param offset Index of the first entry of the part in the whole data array
+*/
+void
+initializeData(DATA_TYPE_UNSIGNED* data, size_t size, size_t offset);
+
+/**
+Copies the equally sized chunks of all replications into a single data array
+
+@param chunks The data chunks of all replications in order
+@param data The data array with space for dataSize entries
+@param dataSize Total number of entries in all chunks
+*/
+void
+mergeChunks(std::vector<DATA_TYPE_UNSIGNED*> const &chunks,
+            DATA_TYPE_UNSIGNED* data, size_t dataSize);
+
+/**
+Applies the 4 * dataSize updates of the benchmark with the uniform
+distribution to all words of the addressed entries on the host. Since the
+updates are their own inverse, this reverts the updates done on the device.
+
+@param data The data array
+@param dataSize Number of entries in the data array. Has to be a power of
+                two.
+*/
+void
+replayUpdates(DATA_TYPE_UNSIGNED* data, size_t dataSize);
+
+/**
+Counts the entries of the data array with at least one word that does not
+contain its own index
+
+@param data The data array
+@param dataSize Number of entries in the data array
+
+@return The number of wrong entries
+*/
+size_t
+countErrors(DATA_TYPE_UNSIGNED const* data, size_t dataSize);
+
+/**
+Verifies the data array after the updates with the given operation were
+executed on the device. Depending on the operation the updates are reverted
+or the expected data array is calculated by replaying the updates.
+
+@param data The data array. Its content may be modified by the verification.
+@param dataSize Number of entries in the data array. Has to be a power of
+                two.
+@param blockTable The block table of the address distribution as returned
+                by bm_distribution::createBlockTable()
+@param operation The operation used for the updates, e.g. OPERATION_XOR
+@param executions Number of kernel executions since the data array was
+                initialized
+@param errorMap If not nullptr, the wrong entries are also counted in the
+                chunks and regions of this map
+
+@return The number of wrong entries
+*/
+size_t
+verifyData(DATA_TYPE_UNSIGNED* data, size_t dataSize,
+           std::vector<cl_uint> const &blockTable, int operation,
+           size_t executions, bm_execution::ErrorMap* errorMap);
+
+/**
+Verifies the table of a tenant in the multi-tenant mode like verifyData()
+for the uniform distribution. The kernel of the tenant starts its updates
+after the given number of updates of the sequence instead of the start of
+the sequence.
+
+@param data The table of the tenant. Its content may be modified by the
+                verification.
+@param dataSize Number of entries in the table. Has to be a power of two.
+@param operation The operation used for the updates, e.g. OPERATION_XOR
+@param executions Number of kernel executions since the table was
+                initialized
+@param first Number of updates of the sequence before the first update of
+                the tenant
+
+@return The number of wrong entries
+*/
+size_t
+verifyTenantData(DATA_TYPE_UNSIGNED* data, size_t dataSize, int operation,
+                 size_t executions, DATA_TYPE_UNSIGNED first);
+
+/**
+Calculates the checksums the kernels have to return for OPERATION_GATHER.
+Every checksum is the XOR of all words of the entries loaded from the chunk
+of a replication. Like in the kernels, the entries behind the last chunk are
+skipped if the data size is not a multiple of the replications.
+
+@param dataSize Number of entries in the data array. Has to be a power of
+                two.
+@param blockTable The block table of the address distribution
+@param replications Number of replications the data array is split into
+
+@return The expected checksum of every replication
+*/
+std::vector<DATA_TYPE_UNSIGNED>
+calculateChecksums(size_t dataSize, std::vector<cl_uint> const &blockTable,
+                   size_t replications);
+
+/**
+Calculates the checksum the kernel of a tenant in the multi-tenant mode has
+to return for OPERATION_GATHER with the uniform distribution
+
+@param dataSize Number of entries in the table of the tenant. Has to be a
+                power of two.
+@param first Number of updates of the sequence before the first update of
+                the tenant
+
+@return The XOR of all words of the entries loaded by the tenant
+*/
+DATA_TYPE_UNSIGNED
+calculateTenantChecksum(size_t dataSize, DATA_TYPE_UNSIGNED first);
+
+/**
+Compares the checksums returned by the kernels with the expected checksums.
+All entries of the chunk of a replication are counted as wrong, if its
+checksum does not match.
+
+@param checksums The checksums returned by the kernels of all replications
+@param dataSize Number of entries in the data array
+@param blockTable The block table of the address distribution
+@param errorMap If not nullptr, the entries counted as wrong are also added
+                to the chunks and regions of this map
+
+@return The number of entries counted as wrong
+*/
+size_t
+countChecksumErrors(std::vector<DATA_TYPE_UNSIGNED> const &checksums,
+                    size_t dataSize, std::vector<cl_uint> const &blockTable,
+                    bm_execution::ErrorMap* errorMap);
+
+}  // namespace bm_verification
+
+#endif  // SRC_HOST_VERIFICATION_H_
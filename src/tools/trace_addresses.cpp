@@ -0,0 +1,167 @@
+/*
+Copyright (c) 2019 Marius Meyer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* C++ standard library headers */
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* External library headers */
+#include "cxxopts.hpp"
+
+/* Project's headers */
+#include "src/host/address_distribution.h"
+#include "src/host/address_trace.h"
+#include "src/host/fpga_setup.h"
+#include "src/host/random_access_definitions.h"
+
+/**
+Number of updates in a batch of the kernels if it is not given
+*/
+#ifndef UPDATE_SPLIT
+#define UPDATE_SPLIT 1024
+#endif
+
+/**
+The entry point of the address trace tool. Writes the address stream of the
+kernels to a trace file and/or replays a trace against a DRAM geometry.
+No OpenCL device is needed.
+*/
+int
+main(int argc, char * argv[]) {
+    cxxopts::Options options(argv[0], "Export and analysis of the address "\
+                             "stream of the random access benchmark");
+    options.add_options()
+        ("o,output", "Write the address stream to the given trace file",
+            cxxopts::value<std::string>()->default_value(""))
+        ("a,analyze", "Replay the given trace file against the DRAM "\
+        "geometry. Defaults to the file given with -o.",
+            cxxopts::value<std::string>()->default_value(""))
+        ("d,data", "Size of the data array in entries",
+            cxxopts::value<size_t>()->default_value(
+                                std::to_string(DATA_LENGTH / ENTRY_WIDTH)))
+        ("r", "Number of kernel replications the data array is split into",
+            cxxopts::value<uint>()->default_value(std::to_string(REPLICATIONS)))
+        ("replication", "Only write the accesses of the data chunk of the "\
+        "given replication. -1 writes the whole address stream.",
+            cxxopts::value<int>()->default_value(
+                            std::to_string(ADDRESS_TRACE_ALL_REPLICATIONS)))
+        ("update-split", "Number of updates in a batch of the kernels. "\
+        "If 0, the value stored in the trace is used for the analysis.",
+            cxxopts::value<size_t>()->default_value("0"))
+        ("banks", "Number of DRAM banks",
+            cxxopts::value<size_t>()->default_value("16"))
+        ("row-size", "Size of a DRAM row in Byte",
+            cxxopts::value<size_t>()->default_value("8192"))
+        ("burst", "Size of a memory burst in Byte",
+            cxxopts::value<size_t>()->default_value("64"))
+        ("operation", "Operation of the kernels: xor, add, scatter, gather "\
+        "or cas",
+            cxxopts::value<std::string>()
+                                ->default_value(operationName(OPERATION)))
+        ("distribution", "Address distribution of the updates: uniform, "\
+        "zipf or hotset",
+            cxxopts::value<std::string>()->default_value("uniform"))
+        ("zipf-s", "Exponent of the zipf distribution",
+            cxxopts::value<double>()->default_value("0.99"))
+        ("hot-fraction", "Fraction of the entries in the hot set",
+            cxxopts::value<double>()->default_value("0.1"))
+        ("hot-probability", "Fraction of the updates to the hot set",
+            cxxopts::value<double>()->default_value("0.9"))
+        ("bank-bias", "Comma separated weights of the data chunks of all "\
+        "replications, e.g. 4,1,1,1",
+            cxxopts::value<std::string>()->default_value(""))
+        ("h,help", "Print this help");
+    cxxopts::ParseResult result = options.parse(argc, argv);
+    if (result.count("h")) {
+        std::cout << options.help() << std::endl;
+        exit(0);
+    }
+    std::string outputFile = result["output"].as<std::string>();
+    std::string analyzeFile = result["analyze"].as<std::string>();
+    if (analyzeFile.empty()) {
+        analyzeFile = outputFile;
+    }
+    if (analyzeFile.empty()) {
+        std::cerr << "A trace file has to be given with -o or -a! Aborting"
+                  << std::endl;
+        std::cout << options.help() << std::endl;
+        exit(1);
+    }
+    int operation = operationFromName(result["operation"].as<std::string>());
+    if (operation < 0) {
+        std::cerr << "Unknown operation "
+                  << result["operation"].as<std::string>() << "! Aborting"
+                  << std::endl;
+        exit(1);
+    }
+    size_t dataSize = result["d"].as<size_t>();
+    uint replications = result["r"].as<uint>();
+    int replication = result["replication"].as<int>();
+    if (replication >= static_cast<int>(replications)) {
+        std::cerr << "Replication " << replication << " does not exist! "\
+                     "Aborting" << std::endl;
+        exit(1);
+    }
+    size_t updateSplit = result["update-split"].as<size_t>();
+    std::string distribution = result["distribution"].as<std::string>();
+    if (!bm_distribution::isDistribution(distribution)) {
+        std::cerr << "Unknown distribution " << distribution << "! Aborting"
+                  << std::endl;
+        exit(1);
+    }
+    try {
+        std::vector<cl_uint> blockTable = bm_distribution::createBlockTable(
+                            distribution, result["zipf-s"].as<double>(),
+                            result["hot-fraction"].as<double>(),
+                            result["hot-probability"].as<double>(),
+                            result["bank-bias"].as<std::string>(),
+                            replications);
+
+        if (!outputFile.empty()) {
+            bm_address_trace::writeTrace(outputFile, dataSize, blockTable,
+                                         replications, replication,
+                                         updateSplit > 0 ? updateSplit
+                                                         : UPDATE_SPLIT);
+        }
+
+        std::shared_ptr<bm_address_trace::MappedTrace> trace =
+                                    bm_address_trace::mapTrace(analyzeFile);
+        bm_address_trace::DRAMGeometry geometry {
+                result["banks"].as<size_t>(),
+                result["row-size"].as<size_t>(),
+                result["burst"].as<size_t>(),
+                ENTRY_SIZE,
+                updateSplit > 0 ? updateSplit : trace->header->updateSplit,
+                operation};
+        std::shared_ptr<bm_address_trace::AnalysisResults> results =
+                            bm_address_trace::analyzeTrace(*trace, geometry);
+        bm_address_trace::printAnalysis(*trace, geometry, *results);
+    } catch (std::runtime_error const &error) {
+        std::cerr << error.what() << "! Aborting" << std::endl;
+        return 1;
+    }
+    return 0;
+}